@@ -0,0 +1,167 @@
+/**
+ * @file alloc_bench.cpp
+ * @brief Allocation churn: raw parallax_umalloc vs the caching UnifiedPool
+ *
+ * Mirrors what every benchmark iteration does (allocate, touch, free) at
+ * several sizes, plus a mixed-size churn and std::vector with the pool
+ * allocator. Reports per-operation latency and how many allocations
+ * actually reached the runtime.
+ */
+
+#include <parallax/runtime.h>
+#include "common/metrics.hpp"
+#include "common/umem_pool.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <string>
+
+class Timer {
+public:
+    void start() { start_ = std::chrono::high_resolution_clock::now(); }
+    double elapsed_ms() {
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start_).count();
+    }
+private:
+    std::chrono::time_point<std::chrono::high_resolution_clock> start_;
+};
+
+static std::string format_bytes(size_t bytes) {
+    if (bytes >= (size_t(1) << 20)) return std::to_string(bytes >> 20) + " MiB";
+    if (bytes >= (size_t(1) << 10)) return std::to_string(bytes >> 10) + " KiB";
+    return std::to_string(bytes) + " B";
+}
+
+// Touch one byte per page so lazily backed memory is really committed
+static void touch(void* p, size_t bytes) {
+    auto* c = static_cast<volatile char*>(p);
+    for (size_t i = 0; i < bytes; i += 4096) c[i] = 1;
+}
+
+struct ChurnResult {
+    double raw_us;
+    double pool_us;
+    uint64_t pool_driver_allocs;
+    bool ok;
+};
+
+ChurnResult churn(const std::vector<size_t>& sizes, int iterations) {
+    ChurnResult result{0.0, 0.0, 0, true};
+    const int ops = iterations * static_cast<int>(sizes.size());
+    Timer timer;
+    
+    timer.start();
+    for (int it = 0; it < iterations && result.ok; it++) {
+        for (size_t bytes : sizes) {
+            void* p = parallax_umalloc(bytes, 0);
+            if (!p) { result.ok = false; break; }
+            touch(p, bytes);
+            parallax_ufree(p);
+        }
+    }
+    result.raw_us = timer.elapsed_ms() * 1000.0 / ops;
+    
+    auto& pool = parallax::samples::UnifiedPool::instance();
+    pool.trim();
+    uint64_t before = pool.stats().driver_allocs;
+    timer.start();
+    for (int it = 0; it < iterations && result.ok; it++) {
+        for (size_t bytes : sizes) {
+            void* p = pool.allocate(bytes);
+            if (!p) { result.ok = false; break; }
+            touch(p, bytes);
+            pool.deallocate(p);
+        }
+    }
+    result.pool_us = timer.elapsed_ms() * 1000.0 / ops;
+    result.pool_driver_allocs = pool.stats().driver_allocs - before;
+    return result;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Allocation Churn Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    const int iterations = 200;
+    
+    std::cout << std::left << std::setw(14) << "Size"
+              << std::setw(14) << "Raw (us/op)"
+              << std::setw(14) << "Pool (us/op)"
+              << std::setw(10) << "Speedup"
+              << std::setw(16) << "Driver allocs"
+              << "Status" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+    
+    bool ok = true;
+    auto print_row = [&](const std::string& label, const ChurnResult& r, int ops) {
+        ok = ok && r.ok;
+        std::cout << std::left << std::setw(14) << label
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << r.raw_us
+                  << std::setw(14) << r.pool_us
+                  << std::setw(10) << (r.raw_us / r.pool_us)
+                  << std::setw(16) << (std::to_string(r.pool_driver_allocs) + "/" + std::to_string(ops))
+                  << (r.ok ? "✓ PASS" : "✗ FAIL") << std::endl;
+    };
+    
+    // 4 KiB .. 400 MiB (the 100M-float benchmark buffer)
+    const std::vector<size_t> sizes = {
+        size_t(4) << 10, size_t(64) << 10, size_t(1) << 20,
+        size_t(16) << 20, size_t(400) << 20
+    };
+    for (size_t bytes : sizes) {
+        int iters = bytes >= (size_t(100) << 20) ? 10 : iterations;
+        print_row(format_bytes(bytes), churn({bytes}, iters), iters);
+    }
+    
+    // Mixed sizes in one loop: each class gets its own free list
+    std::vector<size_t> mixed = {size_t(3000), size_t(70) << 10, size_t(1) << 20, size_t(5) << 20, size_t(12) << 10};
+    print_row("mixed", churn(mixed, iterations), iterations * static_cast<int>(mixed.size()));
+    
+    // std::vector with the pool allocator (what an offloaded container uses)
+    {
+        const size_t N = 1'000'000;
+        Timer timer;
+        timer.start();
+        for (int it = 0; it < iterations; it++) {
+            std::vector<float, parallax::samples::pool_allocator<float>> v(N, 1.0f);
+        }
+        double pool_us = timer.elapsed_ms() * 1000.0 / iterations;
+        
+        timer.start();
+        for (int it = 0; it < iterations; it++) {
+            float* v = (float*)parallax_umalloc(N * sizeof(float), 0);
+            if (!v) {
+                std::cerr << "Failed to allocate " << N << " floats" << std::endl;
+                ok = false;
+                break;
+            }
+            std::fill(v, v + N, 1.0f);
+            parallax_ufree(v);
+        }
+        double raw_us = timer.elapsed_ms() * 1000.0 / iterations;
+        
+        std::cout << std::endl;
+        std::cout << "std::vector<float, pool_allocator> (1M): " << std::fixed << std::setprecision(2)
+                  << pool_us << " us/op vs " << raw_us << " us/op raw" << std::endl;
+    }
+    
+    auto stats = parallax::samples::UnifiedPool::instance().stats();
+    std::cout << "Pool: " << stats.requests << " requests, " << stats.pool_hits << " hits, "
+              << stats.driver_allocs << " driver allocations, peak "
+              << format_bytes(stats.peak_bytes_in_use) << " in use" << std::endl;
+    parallax::samples::UnifiedPool::instance().trim();
+    parallax::samples::print_metrics();
+    
+    std::cout << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Benchmark Complete!" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    return ok ? 0 : 1;
+}
@@ -6,6 +6,13 @@
 #include <vector>
 #include <numeric>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <functional>
+#include <type_traits>
 
 #include <parallax/runtime.h>
 #include <parallax/runtime.hpp>
@@ -13,169 +20,554 @@
 #include <parallax/unified_buffer.hpp>
 #include <parallax/execution_policy.hpp>
 #include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/device_info.hpp"
+#include "common/host_parallel.hpp"
+#include "common/metrics.hpp"
 
-struct BenchConfig {
-    size_t size;
-    int iterations;
-    std::string name;
-};
+#ifdef __linux__
+#include <time.h>
+#include <unistd.h>
+#endif
 
-struct BenchResult {
-    std::string name;
-    size_t size;
-    double cpu_time_ms;
-    double gpu_time_ms;
-    double speedup;
-    bool correct;
-};
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+using parallax::samples::host_block_count;
+using parallax::samples::host_parallel_for;
+using parallax::samples::host_parallel_indexed_blocks;
+using parallax::samples::host_parallel_reduce;
 
-class Timer {
+// Runtime counters taken before a GPU measure. ran_on_gpu() is false when
+// the calls since then launched nothing or fell back to the CPU. Offloaded
+// par calls are only counted by the runtime, so without parallax_get_stats
+// there is nothing to check and it returns true.
+class OffloadCheck {
 public:
-    void start() { start_ = std::chrono::high_resolution_clock::now(); }
-    double elapsed_ms() {
-        auto end = std::chrono::high_resolution_clock::now();
-        return std::chrono::duration<double, std::milli>(end - start_).count();
+    OffloadCheck() : before_(parallax::samples::metrics().snapshot()) {}
+
+    bool ran_on_gpu() const {
+        auto after = parallax::samples::metrics().snapshot();
+        if (!after.runtime_known) return true;
+        return after.runtime_launches > before_.runtime_launches &&
+               after.runtime_cpu_fallbacks == before_.runtime_cpu_fallbacks;
     }
+
 private:
-    std::chrono::time_point<std::chrono::high_resolution_clock> start_;
+    parallax::samples::MetricsSnapshot before_;
 };
 
-BenchResult bench_for_each(const BenchConfig& config) {
-    BenchResult result;
-    result.name = "for_each";
-    result.size = config.size;
-    
+struct BenchConfig {
+    size_t size;
+    int repetitions;  // Default; --reps overrides
+    std::string name;
+};
+
+void bench_for_each(BenchHarness& h, const BenchConfig& config) {
     float* data = (float*)parallax_umalloc(config.size * sizeof(float), 0);
     for (size_t i = 0; i < config.size; i++) data[i] = static_cast<float>(i);
     
     std::vector<float> cpu_data(data, data + config.size);
-    Timer timer;
     
     // CPU baseline
-    timer.start();
-    for (int i = 0; i < config.iterations; i++) {
-        std::for_each(std::execution::par, cpu_data.begin(), cpu_data.end(),
-                     [](float& x) { x = x * 2.0f + 1.0f; });
-    }
-    result.cpu_time_ms = timer.elapsed_ms() / config.iterations;
+    auto cpu = h.measure([&] {
+        host_parallel_for(config.size, [&](size_t i) { cpu_data[i] = cpu_data[i] * 2.0f + 1.0f; });
+    }, config.repetitions);
     
     // GPU - Intercepted!
-    timer.start();
-    for (int i = 0; i < config.iterations; i++) {
+    OffloadCheck offload;
+    auto gpu = h.measure([&] {
         std::for_each(std::execution::par, data, data + config.size,
                      [](float& x) { x = x * 2.0f + 1.0f; });
-    }
-    result.gpu_time_ms = timer.elapsed_ms() / config.iterations;
+    }, config.repetitions);
     
-    result.correct = true;
+    // Both sides ran the same number of times, so values grew alike
+    bool correct = offload.ran_on_gpu();
     for (size_t i = 0; i < std::min(size_t(1000), config.size); i++) {
-        if (std::abs(data[i] - cpu_data[i]) > 1e-4f) { result.correct = false; break; }
+        if (std::abs(data[i] - cpu_data[i]) > 1e-5f * std::abs(cpu_data[i]) + 1e-4f) { correct = false; break; }
     }
-    result.speedup = result.cpu_time_ms / result.gpu_time_ms;
+    Work work{2.0 * sizeof(float) * config.size, 2.0 * config.size};
+    h.record("for_each", "cpu", config.size, cpu, work);
+    h.record("for_each", "gpu", config.size, gpu, work, correct);
     parallax_ufree(data);
-    return result;
 }
 
-BenchResult bench_transform(const BenchConfig& config) {
-    BenchResult result;
-    result.name = "transform";
-    result.size = config.size;
+// Same increment over different element types: GB/s across these rows
+// shows which types get a wide (vec4, multi-element) kernel variant.
+// Small integers are exact in every type, half included.
+template<typename T>
+void bench_for_each_typed(BenchHarness& h, const BenchConfig& config, const std::string& name) {
+    T* data = (T*)parallax_umalloc(config.size * sizeof(T), 0);
+    for (size_t i = 0; i < config.size; i++) data[i] = static_cast<T>(i % 64);
+    
+    std::vector<T> cpu_data(data, data + config.size);
+    auto increment = [](T& x) { x = static_cast<T>(x + static_cast<T>(1)); };
     
+    auto cpu = h.measure([&] {
+        host_parallel_for(config.size, [&](size_t i) { increment(cpu_data[i]); });
+    }, config.repetitions);
+    
+    OffloadCheck offload;
+    auto gpu = h.measure([&] {
+        std::for_each(std::execution::par, data, data + config.size, increment);
+    }, config.repetitions);
+    
+    bool correct = offload.ran_on_gpu();
+    for (size_t i = 0; i < std::min(size_t(1000), config.size); i++) {
+        if (static_cast<double>(data[i]) != static_cast<double>(cpu_data[i])) { correct = false; break; }
+    }
+    Work work{2.0 * sizeof(T) * config.size, static_cast<double>(config.size)};
+    h.record(name, "cpu", config.size, cpu, work);
+    h.record(name, "gpu", config.size, gpu, work, correct);
+    parallax_ufree(data);
+}
+
+void bench_transform(BenchHarness& h, const BenchConfig& config) {
     float* in = (float*)parallax_umalloc(config.size * sizeof(float), 0);
     float* out = (float*)parallax_umalloc(config.size * sizeof(float), 0);
     for (size_t i = 0; i < config.size; i++) in[i] = static_cast<float>(i + 1);
     
     std::vector<float> cpu_in(in, in + config.size);
     std::vector<float> cpu_out(config.size);
-    Timer timer;
     
-    timer.start();
-    for (int i = 0; i < config.iterations; i++) {
-        std::transform(std::execution::par, cpu_in.begin(), cpu_in.end(), cpu_out.begin(),
-                      [](float x) { return std::sqrt(x) * 2.0f; });
-    }
-    result.cpu_time_ms = timer.elapsed_ms() / config.iterations;
+    auto cpu = h.measure([&] {
+        host_parallel_for(config.size, [&](size_t i) { cpu_out[i] = std::sqrt(cpu_in[i]) * 2.0f; });
+    }, config.repetitions);
     
-    timer.start();
-    for (int i = 0; i < config.iterations; i++) {
+    OffloadCheck offload;
+    auto gpu = h.measure([&] {
         std::transform(std::execution::par, in, in + config.size, out,
                       [](float x) { return std::sqrt(x) * 2.0f; });
-    }
-    result.gpu_time_ms = timer.elapsed_ms() / config.iterations;
+    }, config.repetitions);
     
-    result.correct = true;
+    bool correct = offload.ran_on_gpu();
     for (size_t i = 0; i < std::min(size_t(1000), config.size); i++) {
-        if (std::abs(out[i] - cpu_out[i]) > 1e-3f) { result.correct = false; break; }
+        if (std::abs(out[i] - cpu_out[i]) > 1e-3f) { correct = false; break; }
     }
-    result.speedup = result.cpu_time_ms / result.gpu_time_ms;
+    Work work{2.0 * sizeof(float) * config.size, 2.0 * config.size};
+    h.record("transform", "cpu", config.size, cpu, work);
+    h.record("transform", "gpu", config.size, gpu, work, correct);
     parallax_ufree(in);
     parallax_ufree(out);
-    return result;
 }
 
-BenchResult bench_reduce(const BenchConfig& config) {
-    BenchResult result;
-    result.name = "reduce";
-    result.size = config.size;
+// Binary transform: y = a * x + y, both inputs and the output bound as
+// buffers of one dispatch. y is restored before every run.
+void bench_saxpy(BenchHarness& h, const BenchConfig& config) {
+    const float a = 2.5f;
+    float* x = (float*)parallax_umalloc(config.size * sizeof(float), 0);
+    float* y = (float*)parallax_umalloc(config.size * sizeof(float), 0);
+    std::vector<float> y0(config.size);
+    for (size_t i = 0; i < config.size; i++) {
+        x[i] = static_cast<float>(i % 1000) * 0.5f;
+        y0[i] = static_cast<float>(i % 7);
+    }
+    
+    std::vector<float> cpu_x(x, x + config.size);
+    std::vector<float> cpu_y(config.size);
+    auto saxpy = [a](float xi, float yi) { return a * xi + yi; };
+    
+    auto cpu = h.measure([&] { std::copy(y0.begin(), y0.end(), cpu_y.begin()); }, [&] {
+        host_parallel_for(config.size, [&](size_t i) { cpu_y[i] = saxpy(cpu_x[i], cpu_y[i]); });
+    }, config.repetitions);
+    
+    OffloadCheck offload;
+    auto gpu = h.measure([&] { std::copy(y0.begin(), y0.end(), y); }, [&] {
+        std::transform(std::execution::par, x, x + config.size, y, y, saxpy);
+    }, config.repetitions);
+    const bool on_gpu = offload.ran_on_gpu();
+    
+    bool correct = on_gpu && std::equal(cpu_y.begin(), cpu_y.begin() + std::min(size_t(1000), config.size), y,
+                              [](float c, float g) { return std::abs(c - g) <= 1e-5f * std::abs(c) + 1e-5f; });
+    // Read x and y, write y
+    Work work{3.0 * sizeof(float) * config.size, 2.0 * config.size};
+    h.record("saxpy", "cpu", config.size, cpu, work);
+    h.record("saxpy", "gpu", config.size, gpu, work, correct);
+    parallax_ufree(x);
+    parallax_ufree(y);
+}
+
+// Small repeating values keep 100M-element int sums in range. Float sums
+// of them are not accurate in single precision (a serial float sum stops
+// growing at 2^26 here), so float results are checked against a double
+// reference, which is exact for these multiples of 1/4.
+template<typename T>
+T sample_value(size_t i) {
+    if constexpr (std::is_integral_v<T>) return static_cast<T>(i % 16);
+    else return static_cast<T>(i % 16) * static_cast<T>(0.25);
+}
+
+// Relative tolerance for floats: the GPU tree rounds differently from
+// the exact reference
+template<typename R, typename T>
+bool reduce_matches(R expected, T gpu) {
+    if constexpr (std::is_integral_v<T>) {
+        return expected == gpu;
+    } else {
+        return std::abs(static_cast<double>(expected) - static_cast<double>(gpu)) <=
+               1e-3 * std::abs(static_cast<double>(expected)) + 1e-3;
+    }
+}
+
+// CPU side folds per-thread partials with host_parallel_reduce, which never
+// leaves the host; GPU side reduces the unified buffer, which the execution
+// policy offloads as a tree reduction with a single scalar read back.
+// @p ref_op is @p op over the reference type (double for floats), used
+// untimed for the correctness check.
+template<typename T, typename Op, typename RefOp = Op>
+void bench_reduce(BenchHarness& h, const BenchConfig& config, const std::string& name, T init, Op op,
+                  RefOp ref_op = RefOp()) {
+    using Ref = std::conditional_t<std::is_floating_point_v<T>, double, T>;
+    T* data = (T*)parallax_umalloc(config.size * sizeof(T), 0);
+    for (size_t i = 0; i < config.size; i++) data[i] = sample_value<T>(i);
+    
+    std::vector<T> cpu_data(data, data + config.size);
+    const Ref expected = std::accumulate(cpu_data.begin(), cpu_data.end(), static_cast<Ref>(init), ref_op);
+    
+    T cpu_res = init;
+    auto cpu = h.measure([&] {
+        cpu_res = host_parallel_reduce(config.size, init, op, [&](size_t i) { return cpu_data[i]; });
+    }, config.repetitions);
+    
+    T gpu_res = init;
+    OffloadCheck offload;
+    auto gpu = h.measure([&] {
+        gpu_res = std::reduce(std::execution::par, data, data + config.size, init, op);
+    }, config.repetitions);
+    const bool on_gpu = offload.ran_on_gpu();
     
+    Work work{static_cast<double>(sizeof(T)) * config.size, static_cast<double>(config.size)};
+    h.record(name, "cpu", config.size, cpu, work);
+    h.record(name, "gpu", config.size, gpu, work, on_gpu && reduce_matches(expected, gpu_res));
+    parallax_ufree(data);
+}
+
+void bench_transform_reduce(BenchHarness& h, const BenchConfig& config) {
     float* data = (float*)parallax_umalloc(config.size * sizeof(float), 0);
-    for (size_t i = 0; i < config.size; i++) data[i] = 1.0f;
+    for (size_t i = 0; i < config.size; i++) data[i] = sample_value<float>(i);
+    
+    std::vector<float> cpu_data(data, data + config.size);
+    auto square = [](float x) { return x * x; };
+    double expected = 0.0;
+    for (float x : cpu_data) expected += static_cast<double>(x) * x;
     
-    Timer timer;
-    timer.start();
     float cpu_res = 0;
-    for (int i = 0; i < config.iterations; i++) {
-        cpu_res = std::reduce(std::execution::par, data, data + config.size, 0.0f);
+    auto cpu = h.measure([&] {
+        cpu_res = host_parallel_reduce(config.size, 0.0f, std::plus<float>(),
+                                       [&](size_t i) { return square(cpu_data[i]); });
+    }, config.repetitions);
+    
+    float gpu_res = 0;
+    OffloadCheck offload;
+    auto gpu = h.measure([&] {
+        gpu_res = std::transform_reduce(std::execution::par, data, data + config.size,
+                                        0.0f, std::plus<float>(), square);
+    }, config.repetitions);
+    const bool on_gpu = offload.ran_on_gpu();
+    
+    Work work{static_cast<double>(sizeof(float)) * config.size, 2.0 * config.size};
+    h.record("xform_reduce", "cpu", config.size, cpu, work);
+    h.record("xform_reduce", "gpu", config.size, gpu, work, on_gpu && reduce_matches(expected, gpu_res));
+    parallax_ufree(data);
+}
+
+// Two-range transform_reduce (inner product) with a single scalar read back
+void bench_dot(BenchHarness& h, const BenchConfig& config) {
+    float* a = (float*)parallax_umalloc(config.size * sizeof(float), 0);
+    float* b = (float*)parallax_umalloc(config.size * sizeof(float), 0);
+    for (size_t i = 0; i < config.size; i++) {
+        a[i] = sample_value<float>(i);
+        b[i] = sample_value<float>(i + 5);
     }
-    result.cpu_time_ms = timer.elapsed_ms() / config.iterations;
     
-    timer.start();
+    std::vector<float> cpu_a(a, a + config.size);
+    std::vector<float> cpu_b(b, b + config.size);
+    const double expected = std::inner_product(cpu_a.begin(), cpu_a.end(), cpu_b.begin(), 0.0);
+    
+    float cpu_res = 0;
+    auto cpu = h.measure([&] {
+        cpu_res = host_parallel_reduce(config.size, 0.0f, std::plus<float>(),
+                                       [&](size_t i) { return cpu_a[i] * cpu_b[i]; });
+    }, config.repetitions);
+    
     float gpu_res = 0;
-    for (int i = 0; i < config.iterations; i++) {
-        gpu_res = std::reduce(std::execution::par, data, data + config.size, 0.0f);
+    OffloadCheck offload;
+    auto gpu = h.measure([&] {
+        gpu_res = std::transform_reduce(std::execution::par, a, a + config.size, b, 0.0f);
+    }, config.repetitions);
+    const bool on_gpu = offload.ran_on_gpu();
+    
+    Work work{2.0 * sizeof(float) * config.size, 2.0 * config.size};
+    h.record("dot", "cpu", config.size, cpu, work);
+    h.record("dot", "gpu", config.size, gpu, work, on_gpu && reduce_matches(expected, gpu_res));
+    parallax_ufree(a);
+    parallax_ufree(b);
+}
+
+// Host baseline scan in two passes over the same blocks: per-block totals,
+// then each block scans from the sum of the blocks before it
+static void host_scan(const int* in, int* out, size_t n, bool inclusive) {
+    std::vector<int> offsets(host_block_count(n), 0);
+    host_parallel_indexed_blocks(n, [&](size_t b, size_t begin, size_t end) {
+        offsets[b] = std::accumulate(in + begin, in + end, 0);
+    });
+    std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), 0);
+    host_parallel_indexed_blocks(n, [&](size_t b, size_t begin, size_t end) {
+        if (inclusive) std::inclusive_scan(in + begin, in + end, out + begin, std::plus<int>(), offsets[b]);
+        else std::exclusive_scan(in + begin, in + end, out + begin, offsets[b]);
+    });
+}
+
+// Host baseline copy_if: count per block, then each block copies to its
+// offset, which keeps the output stable. Returns the number kept.
+template<typename Pred>
+static size_t host_copy_if(const float* in, float* out, size_t n, Pred keep) {
+    std::vector<size_t> offsets(host_block_count(n), 0);
+    host_parallel_indexed_blocks(n, [&](size_t b, size_t begin, size_t end) {
+        offsets[b] = static_cast<size_t>(std::count_if(in + begin, in + end, keep));
+    });
+    const size_t kept = std::accumulate(offsets.begin(), offsets.end(), size_t(0));
+    std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), size_t(0));
+    host_parallel_indexed_blocks(n, [&](size_t b, size_t begin, size_t end) {
+        std::copy_if(in + begin, in + end, out + offsets[b], keep);
+    });
+    return kept;
+}
+
+// Integer inputs keep 100M-element prefix sums exact
+void bench_scan(BenchHarness& h, const BenchConfig& config, bool inclusive) {
+    const std::string name = inclusive ? "incl_scan" : "excl_scan";
+    
+    int* in = (int*)parallax_umalloc(config.size * sizeof(int), 0);
+    int* out = (int*)parallax_umalloc(config.size * sizeof(int), 0);
+    for (size_t i = 0; i < config.size; i++) in[i] = static_cast<int>(i % 4);
+    
+    std::vector<int> cpu_in(in, in + config.size);
+    std::vector<int> cpu_out(config.size);
+    
+    auto cpu = h.measure([&] {
+        host_scan(cpu_in.data(), cpu_out.data(), config.size, inclusive);
+    }, config.repetitions);
+    
+    OffloadCheck offload;
+    auto gpu = h.measure([&] {
+        if (inclusive) std::inclusive_scan(std::execution::par, in, in + config.size, out);
+        else std::exclusive_scan(std::execution::par, in, in + config.size, out, 0);
+    }, config.repetitions);
+    const bool on_gpu = offload.ran_on_gpu();
+    
+    // The tail carries every partial from the look-back, so check it too
+    bool correct = on_gpu && (out[config.size - 1] == cpu_out[config.size - 1]);
+    for (size_t i = 0; i < std::min(size_t(1000), config.size) && correct; i++) {
+        if (out[i] != cpu_out[i]) correct = false;
     }
-    result.gpu_time_ms = timer.elapsed_ms() / config.iterations;
+    Work work{2.0 * sizeof(int) * config.size, static_cast<double>(config.size)};
+    h.record(name, "cpu", config.size, cpu, work);
+    h.record(name, "gpu", config.size, gpu, work, correct);
+    parallax_ufree(in);
+    parallax_ufree(out);
+}
+
+void bench_sort(BenchHarness& h, const BenchConfig& config) {
+    float* data = (float*)parallax_umalloc(config.size * sizeof(float), 0);
+    std::vector<float> keys(config.size);
+    uint32_t state = 12345u;
+    for (size_t i = 0; i < config.size; i++) {
+        state = state * 1664525u + 1013904223u;  // LCG: reproducible keys
+        keys[i] = static_cast<float>(state >> 8) / 65536.0f - 128.0f;
+    }
+    
+    std::vector<float> cpu_data(config.size);
     
-    result.correct = (std::abs(cpu_res - gpu_res) < 1e-1f);
-    result.speedup = result.cpu_time_ms / result.gpu_time_ms;
+    // Sorting is destructive, so restore the keys outside the timed region.
+    // The host side is a single-threaded std::sort ("seq"), not a parallel
+    // baseline
+    auto seq = h.measure([&] { std::copy(keys.begin(), keys.end(), cpu_data.begin()); },
+                         [&] { std::sort(cpu_data.begin(), cpu_data.end()); },
+                         config.repetitions);
+    
+    OffloadCheck offload;
+    auto gpu = h.measure([&] { std::copy(keys.begin(), keys.end(), data); },
+                         [&] { std::sort(std::execution::par, data, data + config.size); },
+                         config.repetitions);
+    const bool on_gpu = offload.ran_on_gpu();
+    
+    // Comparison sorts have no fixed byte or flop count per element
+    bool correct = on_gpu && std::equal(cpu_data.begin(), cpu_data.end(), data);
+    h.record("sort", "seq", config.size, seq, Work{});
+    h.record("sort", "gpu", config.size, gpu, Work{}, correct);
     parallax_ufree(data);
-    return result;
 }
 
-void print_result(const BenchResult& r) {
-    std::cout << std::left << std::setw(12) << r.name 
-              << std::setw(10) << (r.size >= 1000000 ? std::to_string(r.size/1000000) + "M" : std::to_string(r.size))
-              << std::fixed << std::setprecision(3)
-              << std::setw(12) << r.cpu_time_ms
-              << std::setw(12) << r.gpu_time_ms
-              << std::setw(10) << r.speedup
-              << (r.correct ? "✓ PASS" : "✗ FAIL") << std::endl;
+void bench_copy_if(BenchHarness& h, const BenchConfig& config) {
+    float* in = (float*)parallax_umalloc(config.size * sizeof(float), 0);
+    float* out = (float*)parallax_umalloc(config.size * sizeof(float), 0);
+    for (size_t i = 0; i < config.size; i++) in[i] = static_cast<float>(i % 100);
+    
+    std::vector<float> cpu_in(in, in + config.size);
+    std::vector<float> cpu_out(config.size);
+    auto keep = [](float x) { return x >= 50.0f; };
+    
+    size_t cpu_count = 0;
+    auto cpu = h.measure([&] {
+        cpu_count = host_copy_if(cpu_in.data(), cpu_out.data(), config.size, keep);
+    }, config.repetitions);
+    
+    size_t gpu_count = 0;
+    OffloadCheck offload;
+    auto gpu = h.measure([&] {
+        float* end = std::copy_if(std::execution::par, in, in + config.size, out, keep);
+        gpu_count = static_cast<size_t>(end - out);
+    }, config.repetitions);
+    const bool on_gpu = offload.ran_on_gpu();
+    
+    // copy_if is stable, so the compacted outputs must match element-wise
+    bool correct = on_gpu && (cpu_count == gpu_count);
+    for (size_t i = 0; i < std::min(size_t(1000), gpu_count) && correct; i++) {
+        if (out[i] != cpu_out[i]) correct = false;
+    }
+    // Every input read, half of it written
+    Work work{static_cast<double>(sizeof(float)) * (config.size + gpu_count), static_cast<double>(config.size)};
+    h.record("copy_if", "cpu", config.size, cpu, work);
+    h.record("copy_if", "gpu", config.size, gpu, work, correct);
+    parallax_ufree(in);
+    parallax_ufree(out);
+}
+
+// Milliseconds from exec to now, covering dynamic loading and static
+// initialization before main (clock-tick resolution); -1 if unavailable
+static double ms_since_exec() {
+#ifdef __linux__
+    std::ifstream stat("/proc/self/stat");
+    std::string line;
+    if (!std::getline(stat, line)) return -1.0;
+    // Field 22 (starttime) counts from the ')' that ends the command name
+    size_t pos = line.rfind(')');
+    if (pos == std::string::npos) return -1.0;
+    std::istringstream fields(line.substr(pos + 2));
+    std::string field;
+    for (int i = 3; i < 22 && fields >> field; i++) {}
+    unsigned long long start_ticks = 0;
+    if (!(fields >> start_ticks)) return -1.0;
+    timespec now{};
+    clock_gettime(CLOCK_BOOTTIME, &now);
+    double now_ms = now.tv_sec * 1000.0 + now.tv_nsec / 1e6;
+    return now_ms - start_ticks * 1000.0 / sysconf(_SC_CLK_TCK);
+#else
+    return -1.0;
+#endif
+}
+
+// --startup: how long until the first offloaded call has returned. With
+// PARALLAX_AOT_KERNELS the SPIR-V is embedded at build time and LLVM is
+// not linked, so the first call only creates the pipeline; the JIT build
+// loads LLVM and compiles the lambda on that call.
+static int run_startup(double before_main_ms, double init_ms) {
+    const size_t n = 1024;
+    float* data = (float*)parallax_umalloc(n * sizeof(float), 0);
+    if (!data) {
+        std::cerr << "parallax_umalloc failed" << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < n; i++) data[i] = static_cast<float>(i);
+    
+    auto call = [&] {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::for_each(std::execution::par, data, data + n, [](float& x) { x = x * 2.0f + 1.0f; });
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    };
+    double first_ms = call();
+    double second_ms = call();
+    
+    bool correct = true;
+    for (size_t i = 0; i < n && correct; i++) {
+        float x = static_cast<float>(i);
+        x = x * 2.0f + 1.0f;
+        x = x * 2.0f + 1.0f;
+        correct = std::abs(data[i] - x) <= 1e-4f * std::abs(x);
+    }
+    parallax_ufree(data);
+
+#ifdef PARALLAX_AOT_KERNELS
+    std::cout << "Kernels: embedded at build time (AOT)" << std::endl;
+#else
+    std::cout << "Kernels: compiled at run time (JIT)" << std::endl;
+#endif
+    std::cout << std::fixed << std::setprecision(3);
+    if (before_main_ms >= 0) {
+        std::cout << "  Exec to main (loader):  " << before_main_ms << " ms" << std::endl;
+    }
+    std::cout << "  Runtime init:           " << init_ms << " ms" << std::endl;
+    std::cout << "  First offloaded call:   " << first_ms << " ms" << std::endl;
+    std::cout << "  Second call:            " << second_ms << " ms" << std::endl;
+    std::cout << "  Time to first result:   "
+              << (before_main_ms >= 0 ? before_main_ms : 0.0) + init_ms + first_ms << " ms  "
+              << (correct ? "✓ PASS" : "✗ FAIL") << std::endl;
+    return correct ? 0 : 1;
 }
 
-int main() {
+int main(int argc, char** argv) {
+    const double before_main_ms = ms_since_exec();
+    
+    bool startup = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--startup") == 0) startup = true;
+    }
+    
     std::cout << "Parallax v0.5.0 Alpha - ISO C++ Automatic Offloading" << std::endl;
-    std::cout << "Target: NVIDIA GeForce GTX 980M" << std::endl;
     std::cout << "========================================" << std::endl;
     
+    auto init_start = std::chrono::high_resolution_clock::now();
     auto* backend = parallax::get_global_backend();
     auto* memory = parallax::get_global_memory_manager();
     if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
-
+    double init_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - init_start).count();
+    
+    if (startup) {
+        int status = run_startup(before_main_ms, init_ms);
+        if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+        return status;
+    }
+    
+    // After the --startup branch, which must not pay for the Vulkan query
+    const auto device = parallax::samples::primary_device();
+    std::cout << "Target: " << device.name;
+    if (device.subgroup_size) std::cout << " (subgroup " << device.subgroup_size << ")";
+    std::cout << std::endl;
+    
+    BenchHarness h("auto_lambda_bench", parallax::samples::BenchOptions::parse(argc, argv), device.name);
     std::vector<BenchConfig> configs = {
-        {1000000, 10, "1M"},
-        {10000000, 5, "10M"},
-        {100000000, 1, "100M"}
+        {1000000, 20, "1M"},
+        {10000000, 10, "10M"},
+        {100000000, 5, "100M"}
     };
     
-    std::cout << std::left << std::setw(12) << "Algorithm" << std::setw(10) << "Size" 
-              << std::setw(12) << "CPU (ms)" << std::setw(12) << "GPU (ms)" 
-              << std::setw(10) << "Speedup" << "Status" << std::endl;
-    std::cout << std::string(75, '-') << std::endl;
-
-    for (const auto& c : configs) print_result(bench_for_each(c));
-    for (const auto& c : configs) print_result(bench_transform(c));
-    for (const auto& c : configs) print_result(bench_reduce(c));
-
+    h.print_header();
+    
+    for (const auto& c : configs) bench_for_each(h, c);
+    for (const auto& c : configs) bench_for_each_typed<double>(h, c, "for_each_f64");
+    for (const auto& c : configs) bench_for_each_typed<int32_t>(h, c, "for_each_i32");
+    for (const auto& c : configs) bench_for_each_typed<int8_t>(h, c, "for_each_i8");
+#ifdef __FLT16_MAX__
+    for (const auto& c : configs) bench_for_each_typed<_Float16>(h, c, "for_each_f16");
+#endif
+    for (const auto& c : configs) bench_transform(h, c);
+    for (const auto& c : configs) bench_reduce(h, c, "reduce_f32", 0.0f, std::plus<float>(), std::plus<double>());
+    for (const auto& c : configs) bench_reduce(h, c, "reduce_f64", 0.0, std::plus<double>());
+    for (const auto& c : configs) bench_reduce(h, c, "reduce_i32", 0, std::plus<int>());
+    // Custom associative op compiled by LambdaCompiler
+    for (const auto& c : configs) {
+        bench_reduce(h, c, "reduce_max", 0.0f, [](float a, float b) { return a > b ? a : b; });
+    }
+    for (const auto& c : configs) bench_transform_reduce(h, c);
+    for (const auto& c : configs) bench_saxpy(h, c);
+    for (const auto& c : configs) bench_dot(h, c);
+    for (const auto& c : configs) bench_scan(h, c, true);
+    for (const auto& c : configs) bench_scan(h, c, false);
+    for (const auto& c : configs) bench_sort(h, c);
+    for (const auto& c : configs) bench_copy_if(h, c);
+    
+    int status = h.finish();
     if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
-    return 0;
+    return status;
 }
@@ -1,9 +1,17 @@
 #include <parallax/lambda_compiler.hpp>
 #include <parallax/spirv_generator.hpp>
+#include "common/compile_service.hpp"
+#include "common/kernel_cache.hpp"
+#include "common/metrics.hpp"
+#include "common/spirv_inspect.hpp"
 #include <iostream>
 #include <iomanip>
 #include <vector>
 #include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <cstdint>
+#include <string>
 
 // Simple test: Compile C++ lambdas to SPIR-V
 // This tests the compiler pipeline without runtime integration
@@ -19,13 +27,76 @@ private:
     std::chrono::time_point<std::chrono::high_resolution_clock> start_;
 };
 
-int main() {
+// Opt-in compile-time specialization: each value is its own closure type,
+// so it gets its own kernel with the constant folded in
+template<int Scale>
+auto make_fixed_scale() {
+    return [](float& x) { x *= static_cast<float>(Scale); };
+}
+
+// Distinct bodies standing in for the offloaded lambdas of a larger
+// program, registered for background compilation at startup
+template<int K>
+auto make_startup_kernel() {
+    return [](float& x) { x = x * static_cast<float>(K + 2) + 1.0f; };
+}
+PARALLAX_PRECOMPILE(startup_k0, make_startup_kernel<0>());
+PARALLAX_PRECOMPILE(startup_k1, make_startup_kernel<1>());
+PARALLAX_PRECOMPILE(startup_k2, make_startup_kernel<2>());
+PARALLAX_PRECOMPILE(startup_k3, make_startup_kernel<3>());
+PARALLAX_PRECOMPILE(startup_k4, make_startup_kernel<4>());
+PARALLAX_PRECOMPILE(startup_k5, make_startup_kernel<5>());
+PARALLAX_PRECOMPILE(startup_k6, make_startup_kernel<6>());
+PARALLAX_PRECOMPILE(startup_k7, make_startup_kernel<7>());
+
+// One row of the variant table: what the generator emitted for @p lambda,
+// whose element is @p element_bytes wide. False if it failed to compile
+template<typename Lambda>
+bool report_variant(parallax::LambdaCompiler& compiler, const std::string& name,
+                    size_t element_bytes, Lambda&& lambda) {
+    std::cout << "  " << std::left << std::setw(8) << name;
+    try {
+        Timer timer;
+        timer.start();
+        auto spirv = compiler.compile(lambda);
+        double ms = timer.elapsed_ms();
+        auto info = parallax::samples::inspect_spirv(spirv);
+        if (!info.valid) {
+            std::cout << "✗ FAILED: not a SPIR-V module" << std::endl;
+            return false;
+        }
+        
+        std::string caps;
+        for (uint32_t c : info.capabilities) {
+            if (c == 1) continue;  // Shader: always present
+            caps += (caps.empty() ? "" : ",") + parallax::samples::capability_name(c);
+        }
+        std::cout << std::setw(10) << spirv.size() * 4
+                  << std::setw(10) << std::fixed << std::setprecision(3) << ms
+                  << std::setw(8) << (info.widest_vector > 1 ? "vec" + std::to_string(info.widest_vector) : "scalar")
+                  << std::setw(10) << element_bytes * info.widest_vector
+                  << std::setw(8) << info.local_size_x
+                  << (caps.empty() ? "-" : caps) << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "✗ FAILED: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    bool clear_cache = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--clear-cache") == 0) clear_cache = true;
+    }
+    
     std::cout << "========================================" << std::endl;
     std::cout << "Parallax Lambda → SPIR-V Compiler Test" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << std::endl;
     
     parallax::LambdaCompiler compiler;
+    bool all_ok = true;  // Any FAILED below makes the exit status non-zero
     
     // Test 1: Simple lambda
     std::cout << "Test 1: Compiling simple lambda..." << std::endl;
@@ -44,6 +115,7 @@ int main() {
         std::cout << "  - Kernel name: " << compiler.get_kernel_name(lambda1) << std::endl;
     } catch (const std::exception& e) {
         std::cout << "  ✗ FAILED: " << e.what() << std::endl;
+        all_ok = false;
     }
     
     std::cout << std::endl;
@@ -64,23 +136,214 @@ int main() {
         std::cout << "  - Kernel name: " << compiler.get_kernel_name(lambda2) << std::endl;
     } catch (const std::exception& e) {
         std::cout << "  ✗ FAILED: " << e.what() << std::endl;
+        all_ok = false;
     }
     
     std::cout << std::endl;
     
     // Test 3: Kernel caching
-    std::cout << "Test 3: Testing kernel caching..." << std::endl;
-    timer.start();
+    // The first lookup in a process is either a miss (cold process: nothing
+    // on disk yet) or a disk hit (warm process: an earlier run stored it).
+    // Run the binary twice to see both; --clear-cache forces a cold start.
+    std::cout << "Test 3: Testing kernel cache..." << std::endl;
+    parallax::samples::KernelCache cache;
+    if (clear_cache) cache.clear_disk();
+    std::cout << "  - Cache directory: " << cache.directory().string()
+              << (cache.disk_enabled() ? "" : " (disk layer disabled)") << std::endl;
     try {
-        auto spirv3 = compiler.compile(lambda1);  // Same as lambda1
-        double time3 = timer.elapsed_ms();
+        using Source = parallax::samples::KernelCache::Source;
+        Source first_source, memory_source, disk_source;
         
-        std::cout << "  ✓ SUCCESS" << std::endl;
-        std::cout << "  - Second compilation time: " << std::fixed << std::setprecision(3) 
-                  << time3 << " ms" << std::endl;
-        std::cout << "  - Caching would improve this!" << std::endl;
+        timer.start();
+        auto spirv3 = cache.compile(compiler, lambda1, &first_source);
+        double first_time = timer.elapsed_ms();
+        
+        timer.start();
+        auto spirv4 = cache.compile(compiler, lambda1, &memory_source);
+        double memory_time = timer.elapsed_ms();
+        
+        // Drop the in-memory layer to measure what a fresh process pays
+        cache.clear_memory();
+        timer.start();
+        auto spirv5 = cache.compile(compiler, lambda1, &disk_source);
+        double disk_time = timer.elapsed_ms();
+        
+        bool identical = (spirv3 == spirv4) && (spirv3 == spirv5);
+        all_ok = all_ok && identical;
+        std::cout << (identical ? "  ✓ SUCCESS" : "  ✗ FAILED: cached SPIR-V differs") << std::endl;
+        std::cout << "  - Process start: "
+                  << (first_source == Source::Compiled ? "cold (no on-disk entry)" : "warm (on-disk entry found)")
+                  << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "  - First lookup:  " << first_time << " ms ("
+                  << parallax::samples::KernelCache::to_string(first_source) << ")" << std::endl;
+        std::cout << "  - Memory layer:  " << memory_time << " ms ("
+                  << parallax::samples::KernelCache::to_string(memory_source) << ")" << std::endl;
+        std::cout << "  - Disk layer:    " << disk_time << " ms ("
+                  << parallax::samples::KernelCache::to_string(disk_source) << ")" << std::endl;
+        
+        auto stats = cache.stats();
+        std::cout << "  - Hits: " << stats.memory_hits << " memory, " << stats.disk_hits
+                  << " disk; misses: " << stats.misses << std::endl;
+        if (first_source == Source::Compiled) {
+            std::cout << "  - Run again to measure a warm-process start" << std::endl;
+        }
     } catch (const std::exception& e) {
         std::cout << "  ✗ FAILED: " << e.what() << std::endl;
+        all_ok = false;
+    }
+    
+    std::cout << std::endl;
+    
+    // Test 4: Type-specialized variants
+    // Element type and access width decide how much of the memory bus one
+    // invocation uses: a scalar float load moves 4 bytes, a vec4 load 16.
+    // Measured bandwidth for the same types is in auto_lambda_bench.
+    std::cout << "Test 4: Type-specialized variants..." << std::endl;
+    std::cout << "  " << std::left << std::setw(8) << "Type"
+              << std::setw(10) << "SPIR-V B"
+              << std::setw(10) << "Compile"
+              << std::setw(8) << "Access"
+              << std::setw(10) << "Bytes/op"
+              << std::setw(8) << "Local"
+              << "Capabilities" << std::endl;
+    all_ok = report_variant(compiler, "f32", sizeof(float), lambda1) && all_ok;
+    all_ok = report_variant(compiler, "f64", sizeof(double), [](double& x) { x *= 2.0; }) && all_ok;
+    all_ok = report_variant(compiler, "i32", sizeof(int32_t), [](int32_t& x) { x *= 2; }) && all_ok;
+    all_ok = report_variant(compiler, "i8", sizeof(int8_t), [](int8_t& x) { x = static_cast<int8_t>(x + 1); }) && all_ok;
+#ifdef __FLT16_MAX__
+    all_ok = report_variant(compiler, "f16", sizeof(_Float16),
+                            [](_Float16& x) { x *= static_cast<_Float16>(2.0f); }) && all_ok;
+#else
+    std::cout << "  f16     (no _Float16 in this compiler)" << std::endl;
+#endif
+    std::cout << std::right;
+    
+    std::cout << std::endl;
+    
+    // Test 5: Captured values vs the cache key
+    // Lambdas that differ only in a captured scalar share one body; if the
+    // generator passes captures as push constants they share one kernel.
+    // If it bakes them in, the cache keys each value separately, so either
+    // is correct. The test fails only if the cache returns SPIR-V that
+    // differs from a direct compile, recompiles a value it already has, or
+    // splits a body whose captures are not baked.
+    std::cout << "Test 5: Capture values and the kernel cache..." << std::endl;
+    try {
+        auto make_scale = [](float m) { return [m](float& x) { x *= m; }; };
+        auto spirv_a = compiler.compile(make_scale(1.0f));
+        auto spirv_b = compiler.compile(make_scale(2.0f));
+        bool baked = spirv_a != spirv_b;
+        auto info = parallax::samples::inspect_spirv(spirv_a);
+        
+        const int values = 1000;
+        auto before = cache.stats();
+        timer.start();
+        for (int i = 0; i < values; i++) cache.compile(compiler, make_scale(0.5f + i * 0.001f));
+        double loop_ms = timer.elapsed_ms();
+        auto after = cache.stats();
+        uint64_t compiled = after.misses - before.misses;
+        
+        // Same values again: every one is cached by now
+        timer.start();
+        for (int i = 0; i < values; i++) cache.compile(compiler, make_scale(0.5f + i * 0.001f));
+        double again_ms = timer.elapsed_ms();
+        uint64_t recompiled = cache.stats().misses - after.misses;
+        
+        bool matches = cache.compile(compiler, make_scale(1.0f)) == spirv_a &&
+                       cache.compile(compiler, make_scale(2.0f)) == spirv_b;
+        
+        auto fixed2 = cache.compile(compiler, make_fixed_scale<2>());
+        auto fixed3 = cache.compile(compiler, make_fixed_scale<3>());
+        
+        bool split = !baked && compiled > 1;
+        bool ok = matches && recompiled == 0 && !split;
+        all_ok = all_ok && ok;
+        std::cout << (ok ? "  ✓ SUCCESS"
+                      : !matches ? "  ✗ FAILED: cached SPIR-V differs from a direct compile"
+                      : recompiled ? "  ✗ FAILED: cached capture values were compiled again"
+                                   : "  ✗ FAILED: capture values split the cache") << std::endl;
+        std::cout << "  - " << values << " capture values: " << compiled << " compiled, "
+                  << (after.memory_hits - before.memory_hits) << " memory hits, "
+                  << std::fixed << std::setprecision(3) << loop_ms << " ms total" << std::endl;
+        std::cout << "  - Same values again: " << recompiled << " compiled, " << again_ms << " ms total" << std::endl;
+        std::cout << "  - Captures passed as: "
+                  << (baked ? "constants in the code (keyed per value)" : "launch parameters (keyed per body)")
+                  << "; " << info.push_constant_blocks << " push-constant block(s), "
+                  << info.spec_constants << " spec constant(s)" << std::endl;
+        std::cout << "  - Template-parameter values: "
+                  << (fixed2 != fixed3 ? "specialized, one kernel per value" : "identical SPIR-V") << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ FAILED: " << e.what() << std::endl;
+        all_ok = false;
+    }
+    
+    std::cout << std::endl;
+    
+    // Test 6: Time to first GPU launch, with and without the manifest
+    // Without it each first call compiles in line and stalls; with it the
+    // kernels compile in the background from startup and first calls that
+    // arrive early run the CPU fallback instead of waiting.
+    std::cout << "Test 6: Background compilation from the startup manifest..." << std::endl;
+    try {
+        auto entries = parallax::samples::CompileManifest::instance().entries();
+        auto scratch = std::filesystem::temp_directory_path();
+        std::vector<float> host(1024, 1.0f);
+        auto cpu_fallback = [&] { for (float& v : host) v = v * 2.0f + 1.0f; };
+        
+        // Without: every entry compiled by its first caller, cold cache
+        parallax::samples::KernelCache inline_cache(parallax::samples::KernelCache::default_device(),
+                                                    __DATE__ " " __TIME__, scratch / "parallax-compiler-test-inline");
+        inline_cache.clear_disk();
+        double inline_total = 0.0, inline_max = 0.0;
+        bool inline_ok = true;
+        for (auto& [name, job] : entries) {
+            timer.start();
+            inline_ok = !job(compiler, inline_cache).empty() && inline_ok;
+            double stall = timer.elapsed_ms();
+            inline_total += stall;
+            inline_max = std::max(inline_max, stall);
+        }
+        
+        // With: service started at "startup", first calls arrive right away
+        parallax::samples::KernelCache service_cache(parallax::samples::KernelCache::default_device(),
+                                                     __DATE__ " " __TIME__, scratch / "parallax-compiler-test-service");
+        service_cache.clear_disk();
+        timer.start();
+        parallax::samples::CompileService service(service_cache);
+        service.submit(parallax::samples::CompileManifest::instance());
+        
+        double call_stall = 0.0;
+        int on_cpu = 0;
+        for (auto& [name, job] : entries) {
+            auto kernel = service.handle(name);
+            auto call_start = std::chrono::high_resolution_clock::now();
+            bool gpu = parallax::samples::run_when_ready(kernel, cpu_fallback, [](const std::vector<uint32_t>&) {});
+            call_stall += std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - call_start).count();
+            if (!gpu) on_cpu++;
+        }
+        service.wait_all();
+        double service_ready = timer.elapsed_ms();
+        
+        bool service_ok = true;
+        for (auto& [name, job] : entries) service_ok = service.handle(name).ok() && service_ok;
+        
+        bool ok = inline_ok && service_ok;
+        all_ok = all_ok && ok;
+        std::cout << (ok ? "  ✓ SUCCESS" : "  ✗ FAILED: a manifest kernel did not compile") << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "  - Without manifest: first calls stall " << inline_total << " ms in total (worst "
+                  << inline_max << " ms); last kernel GPU-ready after " << inline_total << " ms" << std::endl;
+        std::cout << "  - With manifest (" << service.thread_count() << " threads): first calls stall "
+                  << call_stall << " ms in total, " << on_cpu << "/" << entries.size()
+                  << " ran on the CPU first; all GPU-ready after " << service_ready << " ms" << std::endl;
+        
+        inline_cache.clear_disk();
+        service_cache.clear_disk();
+    } catch (const std::exception& e) {
+        std::cout << "  ✗ FAILED: " << e.what() << std::endl;
+        all_ok = false;
     }
     
     std::cout << std::endl;
@@ -88,9 +351,14 @@ int main() {
     std::cout << "Compiler Pipeline Test Complete!" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << std::endl;
-    std::cout << "✅ Lambda → LLVM IR → SPIR-V pipeline working!" << std::endl;
-    std::cout << "✅ No pre-compiled shaders used" << std::endl;
-    std::cout << "✅ Automatic compilation verified" << std::endl;
+    if (all_ok) {
+        std::cout << "✅ Lambda → LLVM IR → SPIR-V pipeline working!" << std::endl;
+        std::cout << "✅ No pre-compiled shaders used" << std::endl;
+        std::cout << "✅ Automatic compilation verified" << std::endl;
+    } else {
+        std::cout << "❌ Some tests FAILED (see above)" << std::endl;
+    }
+    parallax::samples::print_metrics();
     
-    return 0;
+    return all_ok ? 0 : 1;
 }
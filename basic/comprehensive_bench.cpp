@@ -1,103 +1,448 @@
 #include <parallax/runtime.h>
 #include <parallax/kernel_launcher.hpp>
 #include <parallax/shaders/vector_multiply.hpp>
+#include "common/bench_harness.hpp"
+#include "common/device_info.hpp"
+#include "common/dispatch_policy.hpp"
+#include "common/host_parallel.hpp"
+#include "common/kernel_preload.hpp"
+#include "common/mem_flags.hpp"
+#include "common/streaming.hpp"
+#include "common/trace.hpp"
 #include <iostream>
 #include <vector>
 #include <chrono>
+#include <algorithm>
+#include <cstring>
 #include <iomanip>
+#include <memory>
+#include <numeric>
+#include <new>
+#include <optional>
 
 extern std::unique_ptr<parallax::VulkanBackend> g_backend;
 extern std::unique_ptr<parallax::MemoryManager> g_memory_manager;
 
-struct BenchmarkResult {
-    size_t size;
-    double cpu_time_ms;
-    double gpu_time_ms;
-    double speedup;
-    bool correct;
+static const std::vector<parallax::samples::KernelSpec> kKernels = {
+    {"vector_multiply", parallax::shaders::VECTOR_MULTIPLY_SPV, parallax::shaders::VECTOR_MULTIPLY_SPV_SIZE},
 };
 
-BenchmarkResult run_benchmark(size_t N) {
-    BenchmarkResult result;
-    result.size = N;
-    
+// Pipelines are built once by preload() in main(). With --cold, each size
+// gets a fresh launcher instead, reproducing the old per-size pipeline cost;
+// that cost is recorded as its own "pipeline" row next to the dispatch rows.
+// profile_launch() then splits a launch into upload, dispatch, fixed
+// overhead and download rows.
+bool run_benchmark(parallax::samples::BenchHarness& h, size_t N, parallax::KernelLauncher* shared_launcher) {
     // Allocate unified memory
     float* data = (float*)parallax_umalloc(N * sizeof(float), 0);
     if (!data) {
         std::cerr << "Failed to allocate " << N << " floats" << std::endl;
-        result.correct = false;
-        return result;
+        // A failed row, so finish() and --compare see the case too
+        h.record("vector_multiply", "gpu", N, {}, {}, false);
+        return false;
     }
     
     // Initialize
+    std::vector<float> input(N);
     for (size_t i = 0; i < N; i++) {
-        data[i] = static_cast<float>(i);
+        input[i] = static_cast<float>(i);
     }
     
     const float multiplier = 2.0f;
+    const int reps = N >= 100000000 ? 5 : 10;
     
-    // CPU baseline
+    // CPU baseline; every run starts again from the initialized input
     std::vector<float> cpu_result(N);
-    std::copy(data, data + N, cpu_result.begin());
-    
-    auto cpu_start = std::chrono::high_resolution_clock::now();
-    for (size_t i = 0; i < N; i++) {
-        cpu_result[i] *= multiplier;
-    }
-    auto cpu_end = std::chrono::high_resolution_clock::now();
-    result.cpu_time_ms = std::chrono::duration<double, std::milli>(cpu_end - cpu_start).count();
+    auto cpu = h.measure([&] { std::copy(input.begin(), input.end(), cpu_result.begin()); },
+                         [&] {
+                             for (size_t i = 0; i < N; i++) {
+                                 cpu_result[i] *= multiplier;
+                             }
+                         }, reps);
     
     // GPU execution
-    if (!g_backend || !g_memory_manager) {
-        std::cerr << "Parallax runtime not initialized" << std::endl;
-        parallax_ufree(data);
-        result.correct = false;
-        return result;
-    }
-    
-    parallax::KernelLauncher launcher(g_backend.get(), g_memory_manager.get());
-    
-    if (!launcher.load_kernel("vector_multiply",
-                               parallax::shaders::VECTOR_MULTIPLY_SPV,
-                               parallax::shaders::VECTOR_MULTIPLY_SPV_SIZE)) {
-        std::cerr << "Failed to load kernel" << std::endl;
-        parallax_ufree(data);
-        result.correct = false;
-        return result;
+    std::unique_ptr<parallax::KernelLauncher> cold_launcher;
+    parallax::KernelLauncher* launcher = shared_launcher;
+    double pipeline_ms = 0.0;
+    if (!launcher) {
+        cold_launcher = std::make_unique<parallax::KernelLauncher>(g_backend.get(), g_memory_manager.get());
+        auto loaded = parallax::samples::preload(*cold_launcher, kKernels);
+        if (!parallax::samples::all_loaded(loaded)) {
+            std::cerr << "Failed to load kernel" << std::endl;
+            h.record("pipeline", "gpu", N, {}, {}, false);
+            parallax_ufree(data);
+            return false;
+        }
+        pipeline_ms = parallax::samples::total_create_ms(loaded);
+        launcher = cold_launcher.get();
     }
     
-    auto gpu_start = std::chrono::high_resolution_clock::now();
-    if (!launcher.launch("vector_multiply", data, N, multiplier)) {
+    // Rewriting the input from the host each run keeps the upload in every
+    // sample, as in a single call on freshly produced data
+    bool launched = true;
+    auto gpu = h.measure([&] { std::copy(input.begin(), input.end(), data); },
+                         [&] { launched = launcher->launch("vector_multiply", data, N, multiplier) && launched; },
+                         reps);
+    if (!launched) {
         std::cerr << "Failed to launch kernel" << std::endl;
-        parallax_ufree(data);
-        result.correct = false;
-        return result;
     }
-    auto gpu_end = std::chrono::high_resolution_clock::now();
-    result.gpu_time_ms = std::chrono::duration<double, std::milli>(gpu_end - gpu_start).count();
     
     // Verify
-    result.correct = true;
+    bool correct = launched;
     size_t errors = 0;
     for (size_t i = 0; i < N && errors < 10; i++) {
         if (std::abs(data[i] - cpu_result[i]) > 1e-5f) {
-            result.correct = false;
+            correct = false;
             errors++;
         }
     }
     
-    result.speedup = result.cpu_time_ms / result.gpu_time_ms;
+    parallax::samples::Work work{2.0 * sizeof(float) * N, static_cast<double>(N)};  // Read + write, one multiply
+    h.record("vector_multiply", "cpu", N, cpu, work);
+    h.record("vector_multiply", "gpu", N, gpu, work, correct);
+    
+    // Where a launch's time goes (PARALLAX_TRACE=file.json exports it too).
+    // Multiplying by 1 leaves the verified data alone
+    if (launched) {
+        std::vector<double> upload, dispatch, overhead, download;
+        parallax::samples::LaunchStats stats;
+        bool profiled = true;
+        for (int i = 0; i < 3; i++) {
+            stats = parallax::samples::profile_launch(*launcher, "vector_multiply", data, N, 1.0f, 1.0f);
+            profiled = profiled && stats.ok;
+            upload.push_back(stats.upload_ms);
+            dispatch.push_back(stats.dispatch_ms);
+            overhead.push_back(stats.overhead_ms);
+            download.push_back(stats.download_ms);
+        }
+        const double bytes = static_cast<double>(stats.upload_bytes);
+        h.record("launch_upload", "gpu", N, parallax::samples::summarize(upload), {bytes, 0.0}, profiled);
+        h.record("launch_disp", "gpu", N, parallax::samples::summarize(dispatch), work, profiled);
+        h.record("launch_ovhd", "gpu", N, parallax::samples::summarize(overhead), {}, profiled);
+        h.record("launch_down", "gpu", N, parallax::samples::summarize(download),
+                 {static_cast<double>(stats.download_bytes), 0.0}, profiled);
+    }
+    if (!shared_launcher) h.record("pipeline", "gpu", N, parallax::samples::summarize({pipeline_ms}), {});
     
     parallax_ufree(data);
-    return result;
+    return correct;
+}
+
+// Run one small dispatch so any lazy driver work happens before the first
+// measured launch.
+bool warmup(parallax::KernelLauncher& launcher) {
+    const size_t N = 256;
+    float* data = (float*)parallax_umalloc(N * sizeof(float), 0);
+    if (!data) return false;
+    for (size_t i = 0; i < N; i++) data[i] = 1.0f;
+    bool ok = launcher.launch("vector_multiply", data, N, 1.0f);
+    parallax_ufree(data);
+    return ok;
+}
+
+static double elapsed_ms(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// --auto: calibrate the CPU/GPU cost model for vector_multiply once per
+// device, then check that the backend it picks at each size is at least
+// as fast as both fixed choices, comparing harness medians.
+int run_auto_mode(parallax::KernelLauncher& launcher, parallax::samples::BenchHarness& h,
+                  const std::vector<size_t>& sizes, bool recalibrate) {
+    const float multiplier = 2.0f;
+    const size_t bytes_per_element = 2 * sizeof(float);  // Read + write
+    auto device = parallax::samples::primary_device();
+    parallax::samples::DispatchPolicy policy(device.key());
+    
+    std::cout << "Auto dispatch on " << device.name << std::endl;
+    
+    if (recalibrate || !policy.calibrated("vector_multiply")) {
+        const size_t max_calibration = 1024000;
+        float* data = (float*)parallax_umalloc(max_calibration * sizeof(float), 0);
+        if (!data) {
+            std::cerr << "Failed to allocate calibration buffer" << std::endl;
+            return 1;
+        }
+        std::vector<float> host(max_calibration, 1.0f);
+        std::fill(data, data + max_calibration, 1.0f);
+        
+        // Host threads rather than std::execution::par, which libstdc++ runs
+        // serially without TBB and would skew the fitted crossover
+        auto cpu = [&](size_t n) {
+            auto start = std::chrono::high_resolution_clock::now();
+            parallax::samples::host_parallel_for(n, [&](size_t i) { host[i] *= multiplier; });
+            return elapsed_ms(start);
+        };
+        auto gpu = [&](size_t n) -> std::optional<double> {
+            auto start = std::chrono::high_resolution_clock::now();
+            if (!launcher.launch("vector_multiply", data, n, multiplier)) return std::nullopt;
+            return elapsed_ms(start);
+        };
+        std::cout << "Calibrating..." << std::endl;
+        auto fitted = policy.calibrate("vector_multiply", bytes_per_element, cpu, gpu,
+                                       {1024, 4096, 16384, 65536, 262144, max_calibration});
+        parallax_ufree(data);
+        if (!fitted) {
+            std::cerr << "Calibration failed: a vector_multiply launch failed" << std::endl;
+            return 1;
+        }
+    }
+    
+    auto model = policy.model("vector_multiply");
+    std::cout << "Crossover: " << parallax::samples::format_crossover(model, bytes_per_element)
+              << " elements (" << policy.path().string() << ")" << std::endl;
+    std::cout << std::endl;
+    h.print_header();
+    
+    bool all_ok = true;
+    std::vector<std::string> reasons;
+    for (size_t N : sizes) {
+        float* data = (float*)parallax_umalloc(N * sizeof(float), 0);
+        if (!data) {
+            std::cerr << "Failed to allocate " << N << " floats" << std::endl;
+            all_ok = false;
+            continue;
+        }
+        std::vector<float> host(N, 1.0f);
+        std::fill(data, data + N, 1.0f);
+        
+        bool launched = true;
+        auto cpu_run = [&] {
+            parallax::samples::host_parallel_for(N, [&](size_t i) { host[i] *= multiplier; });
+        };
+        auto gpu_run = [&] { launched = launcher.launch("vector_multiply", data, N, multiplier) && launched; };
+        
+        // The harness warmups keep page faults and first-touch transfers
+        // from favouring whichever runs second
+        const int reps = N >= 100000000 ? 5 : 10;
+        auto cpu = h.measure(cpu_run, reps);
+        auto gpu = h.measure(gpu_run, reps);
+        parallax::samples::DispatchDecision decision;
+        auto automatic = h.measure([&] {
+            decision = policy.run("vector_multiply", N, N * bytes_per_element, cpu_run, gpu_run);
+        }, reps);
+        
+        // 10% (plus 20us of timer noise) slack over the faster fixed choice;
+        // a failed launch returns early and would otherwise win on time
+        bool ok = launched && automatic.median_ms <= std::min(cpu.median_ms, gpu.median_ms) * 1.10 + 0.02;
+        all_ok = all_ok && ok;
+        reasons.push_back(std::to_string(N) + ": " + parallax::samples::to_string(decision.backend) + ", " +
+                          decision.reason);
+        
+        parallax::samples::Work work{static_cast<double>(N * bytes_per_element), static_cast<double>(N)};
+        h.record("auto_dispatch", "cpu", N, cpu, work);
+        h.record("auto_dispatch", "gpu", N, gpu, work, launched);
+        h.record("auto_dispatch", "auto", N, automatic, work, ok);
+        parallax_ufree(data);
+    }
+    
+    std::cout << "\nDecisions:" << std::endl;
+    for (const auto& r : reasons) std::cout << "  " << r << std::endl;
+    return all_ok ? 0 : 1;
 }
 
-int main() {
+// --streaming: host-resident input pushed through the GPU either as one
+// serialized copy-in / launch / copy-out ("sync"), or chunked so the stages
+// overlap ("strm"). The sync buffer is allocated outside the timed region,
+// so both rows time only the copies and the launches. The 1B-element case
+// (4 GB) only runs streamed.
+int run_streaming_mode(parallax::KernelLauncher& launcher, parallax::samples::BenchHarness& h,
+                       std::vector<size_t> sizes) {
+    const float multiplier = 2.0f;
+    parallax::samples::StreamingOptions options;
+    sizes.push_back(1024000000);  // 1B
+    const size_t serial_limit = 102400000;
+    
+    std::cout << "Streaming: " << (options.chunk_bytes >> 20) << " MiB chunks, depth "
+              << options.depth << std::endl << std::endl;
+    h.print_header();
+    
+    auto kernel = [&](float* chunk, size_t count) {
+        return launcher.launch("vector_multiply", chunk, count, multiplier);
+    };
+    
+    bool all_ok = true;
+    std::vector<std::string> chunk_counts;
+    for (size_t N : sizes) {
+        std::unique_ptr<float[]> host(new (std::nothrow) float[N]);
+        if (!host) {
+            std::cerr << "Failed to allocate " << N << " host floats" << std::endl;
+            h.record("stream", "strm", N, {}, {}, false);
+            all_ok = false;
+            continue;
+        }
+        // Every run starts again from the same input, restored untimed
+        auto reset = [&] {
+            for (size_t i = 0; i < N; i++) host[i] = static_cast<float>(i % 1000);
+        };
+        auto verify = [&] {
+            for (size_t i = 0; i < N; i += 4093) {
+                if (std::abs(host[i] - static_cast<float>(i % 1000) * multiplier) > 1e-5f) return false;
+            }
+            return true;
+        };
+        const int reps = N >= 100000000 ? 3 : 10;
+        // Bytes in plus bytes out
+        parallax::samples::Work work{2.0 * sizeof(float) * N, static_cast<double>(N)};
+        
+        if (N <= serial_limit) {
+            float* data = (float*)parallax_umalloc(N * sizeof(float), 0);
+            bool ok = data != nullptr;
+            parallax::samples::Summary serial;
+            if (data) {
+                serial = h.measure(reset, [&] {
+                    std::memcpy(data, host.get(), N * sizeof(float));
+                    ok = launcher.launch("vector_multiply", data, N, multiplier) && ok;
+                    std::memcpy(host.get(), data, N * sizeof(float));
+                }, reps);
+                ok = ok && verify();
+                parallax_ufree(data);
+            } else {
+                std::cerr << "Failed to allocate " << N << " floats" << std::endl;
+            }
+            all_ok = all_ok && ok;
+            h.record("stream", "sync", N, serial, work, ok);
+        }
+        
+        parallax::samples::StreamingResult streamed;
+        bool ok = true;
+        auto time = h.measure(reset, [&] {
+            streamed = parallax::samples::stream_for_each(host.get(), N, kernel, options);
+            ok = streamed.ok && ok;
+        }, reps);
+        ok = ok && verify();
+        all_ok = all_ok && ok;
+        h.record("stream", "strm", N, time, work, ok);
+        chunk_counts.push_back(parallax::samples::BenchHarness::format_count(N) + ": " +
+                               std::to_string(streamed.chunks) + " chunks");
+    }
+    
+    std::cout << "\nChunks per streamed run:" << std::endl;
+    for (const auto& c : chunk_counts) std::cout << "  " << c << std::endl;
+    return all_ok ? 0 : 1;
+}
+
+// --flags: vector_multiply (by 1, so contents stay checkable) on buffers
+// allocated with each residency hint vs flags 0, in the access pattern the
+// hint is meant for. The "none" row of a case is the reference for Speedup.
+enum class Access { Device, Readback, Stream };
+
+int run_flags_mode(parallax::KernelLauncher& launcher, parallax::samples::BenchHarness& h,
+                   const std::vector<size_t>& sizes) {
+    using parallax::samples::MemHint;
+    struct FlagCase {
+        const char* name;
+        MemHint hint;
+        Access access;
+    };
+    const FlagCase cases[] = {
+        {"mem_device", parallax::samples::kMemDeviceOnly, Access::Device},       // Launches only
+        {"mem_readback", parallax::samples::kMemHostReadMostly, Access::Readback},  // Launch, host reads all
+        {"mem_stream", parallax::samples::kMemStreaming, Access::Stream},        // Host writes all, launch
+    };
+    for (const auto& c : cases) {
+        if (!c.hint.supported) std::cout << c.hint.name << " not defined by this runtime; skipping " << c.name << std::endl;
+        h.set_peak(c.hint.short_name, parallax::samples::Peak::from_env("PARALLAX_PEAK_GBPS", "PARALLAX_PEAK_GFLOPS"));
+    }
+    h.set_peak("none", parallax::samples::Peak::from_env("PARALLAX_PEAK_GBPS", "PARALLAX_PEAK_GFLOPS"));
+    
+    bool all_ok = true;
+    for (size_t N : sizes) {
+        if (N < 1024000) continue;  // Per-launch overhead dominates below 1M
+        std::vector<float> input(N);
+        for (size_t i = 0; i < N; i++) input[i] = static_cast<float>(i % 1000);
+        const int reps = N >= 100000000 ? 5 : 10;
+        
+        for (const auto& c : cases) {
+            if (!c.hint.supported) continue;
+            for (unsigned flags : {0u, c.hint.flags}) {
+                float* data = (float*)parallax_umalloc(N * sizeof(float), flags);
+                if (!data) {
+                    std::cerr << "Failed to allocate " << N << " floats with flags " << flags << std::endl;
+                    all_ok = false;
+                    continue;
+                }
+                const bool host = parallax::samples::host_accessible(flags);
+                if (host) std::copy(input.begin(), input.end(), data);
+                
+                bool launched = true;
+                double readback = 0.0;  // Host sum of the last run, checked below
+                auto time = h.measure([&] {
+                    if (c.access == Access::Stream) std::memcpy(data, input.data(), N * sizeof(float));
+                    launched = launcher.launch("vector_multiply", data, N, 1.0f) && launched;
+                    if (c.access == Access::Readback) readback = std::accumulate(data, data + N, 0.0);
+                }, reps);
+                
+                // Streaming buffers are never read back; device-only ones can't be.
+                // Multiplying by 1 is exact, so the readback sum must match the
+                // input's bit for bit
+                bool correct = launched;
+                if (host && c.access != Access::Stream) {
+                    for (size_t i = 0; i < N && correct; i += 4093) correct = data[i] == input[i];
+                }
+                if (c.access == Access::Readback) {
+                    correct = correct && readback == std::accumulate(input.begin(), input.end(), 0.0);
+                }
+                all_ok = all_ok && correct;
+                // Kernel read + write; the host-side traffic of the pattern shows up as lower GB/s
+                parallax::samples::Work work{2.0 * sizeof(float) * N, static_cast<double>(N)};
+                h.record(c.name, flags == 0 ? "none" : c.hint.short_name, N, time, work, correct);
+                parallax_ufree(data);
+            }
+        }
+    }
+    return all_ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    bool cold = false;
+    bool auto_mode = false;
+    bool recalibrate = false;
+    bool streaming = false;
+    bool flags_mode = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--cold") == 0) cold = true;
+        else if (std::strcmp(argv[i], "--auto") == 0) auto_mode = true;
+        else if (std::strcmp(argv[i], "--recalibrate") == 0) recalibrate = true;
+        else if (std::strcmp(argv[i], "--streaming") == 0) streaming = true;
+        else if (std::strcmp(argv[i], "--flags") == 0) flags_mode = true;
+    }
+    // Auto, streaming and flags modes always use the preloaded launcher
+    cold = cold && !auto_mode && !streaming && !flags_mode;
+    
     std::cout << "========================================" << std::endl;
     std::cout << "Parallax Comprehensive Benchmark Suite" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << std::endl;
     
+    if (!g_backend || !g_memory_manager) {
+        std::cerr << "Parallax runtime not initialized" << std::endl;
+        return 1;
+    }
+    
+    // Build pipelines once, up front
+    parallax::KernelLauncher launcher(g_backend.get(), g_memory_manager.get());
+    std::vector<parallax::samples::PreloadResult> loaded;
+    if (!cold) {
+        loaded = parallax::samples::preload(launcher, kKernels);
+        if (!parallax::samples::all_loaded(loaded)) {
+            std::cerr << "Failed to load kernel" << std::endl;
+            return 1;
+        }
+        for (const auto& k : loaded) {
+            std::cout << "Preloaded " << k.name << ": " << std::fixed << std::setprecision(3)
+                      << k.create_ms << " ms pipeline creation"
+                      << (k.tuned_now ? " (includes first-use tuning)" : "") << std::endl;
+        }
+        if (!warmup(launcher)) {
+            std::cerr << "Warmup launch failed" << std::endl;
+            return 1;
+        }
+    } else {
+        std::cout << "Cold mode: pipelines rebuilt for every size" << std::endl;
+    }
+    std::cout << std::endl;
+    
     // Test sizes: 1K, 10K, 100K, 1M, 10M, 100M
     std::vector<size_t> sizes = {
         1024,           // 1K
@@ -108,38 +453,40 @@ int main() {
         102400000       // 100M
     };
     
-    std::cout << std::setw(12) << "Size"
-              << std::setw(15) << "CPU (ms)"
-              << std::setw(15) << "GPU (ms)"
-              << std::setw(12) << "Speedup"
-              << std::setw(12) << "Status"
-              << std::endl;
-    std::cout << std::string(66, '-') << std::endl;
+    parallax::samples::BenchHarness h("comprehensive_bench", parallax::samples::BenchOptions::parse(argc, argv),
+                                      parallax::samples::primary_device().name);
+    if (streaming) {
+        int failed = run_streaming_mode(launcher, h, sizes);
+        int status = h.finish();
+        return failed ? failed : status;
+    }
+    if (auto_mode) {
+        int failed = run_auto_mode(launcher, h, sizes, recalibrate);
+        int status = h.finish();
+        return failed ? failed : status;
+    }
+    h.print_header();
     
-    for (size_t N : sizes) {
-        auto result = run_benchmark(N);
-        
-        std::string size_str;
-        if (N >= 1000000) {
-            size_str = std::to_string(N / 1000000) + "M";
-        } else if (N >= 1000) {
-            size_str = std::to_string(N / 1000) + "K";
-        } else {
-            size_str = std::to_string(N);
+    // One-off pipeline cost of the preloaded set, as size-0 rows so it
+    // reaches --json / --csv / --compare alongside the dispatch times
+    for (const auto& k : loaded) {
+        h.record("pipeline", "gpu", 0, parallax::samples::summarize({k.create_ms}), {}, k.ok);
+    }
+    
+    int failed = 0;
+    if (flags_mode) {
+        failed = run_flags_mode(launcher, h, sizes);
+    } else {
+        for (size_t N : sizes) {
+            if (!run_benchmark(h, N, cold ? nullptr : &launcher)) failed = 1;
         }
-        
-        std::cout << std::setw(12) << size_str
-                  << std::setw(15) << std::fixed << std::setprecision(3) << result.cpu_time_ms
-                  << std::setw(15) << std::fixed << std::setprecision(3) << result.gpu_time_ms
-                  << std::setw(12) << std::fixed << std::setprecision(2) << result.speedup << "x"
-                  << std::setw(12) << (result.correct ? "✓ PASS" : "✗ FAIL")
-                  << std::endl;
     }
+    int status = h.finish();
     
     std::cout << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "Benchmark Complete!" << std::endl;
     std::cout << "========================================" << std::endl;
     
-    return 0;
+    return failed ? failed : status;
 }
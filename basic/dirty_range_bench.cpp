@@ -0,0 +1,178 @@
+/**
+ * @file dirty_range_bench.cpp
+ * @brief Launch cost vs fraction of a unified buffer touched by the host
+ *
+ * Between launches the host rewrites 0.01% .. 100% of a 400 MB buffer in
+ * 4 KB runs spread across the whole allocation. If the runtime moves only
+ * dirty blocks, the launch cost over a clean launch scales with the dirty
+ * fraction; if it retransfers the buffer, it stays flat at the 100% cost.
+ *
+ * "Implicit" relies on the runtime's own detection; "Explicit" records the
+ * writes with DirtyRangeSet and flushes them via parallax_umark_dirty
+ * (only when the runtime provides it). To measure explicit marking alone,
+ * the explicit case runs on a second buffer allocated with
+ * PARALLAX_MEM_EXPLICIT_DIRTY, which turns implicit tracking off. Without
+ * that flag it shares the implicit buffer, so it pays the runtime's own
+ * coherence work as well; the table then says so and reports the
+ * difference between the two columns instead.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/kernel_launcher.hpp>
+#include <parallax/shaders/vector_multiply.hpp>
+#include "common/dirty_ranges.hpp"
+#include "common/kernel_preload.hpp"
+#include "common/mem_flags.hpp"
+#include "common/metrics.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <string>
+
+extern std::unique_ptr<parallax::VulkanBackend> g_backend;
+extern std::unique_ptr<parallax::MemoryManager> g_memory_manager;
+
+static double elapsed_ms(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Rewrite `fraction` of the buffer as evenly spaced 1024-float runs,
+// optionally recording each run in `tracker`
+static size_t touch_fraction(float* data, size_t n, double fraction,
+                             parallax::samples::DirtyRangeSet* tracker) {
+    const size_t run = 1024;
+    const size_t runs = std::max<size_t>(1, static_cast<size_t>(fraction * n / run));
+    const size_t stride = n / runs;
+    size_t touched = 0;
+    for (size_t r = 0; r < runs; r++) {
+        float* p = data + r * stride;
+        size_t len = std::min(run, n - r * stride);
+        // Same value back through volatile: a real store, unchanged contents
+        volatile float* v = p;
+        for (size_t i = 0; i < len; i++) v[i] = v[i];
+        if (tracker) tracker->mark(p, len * sizeof(float));
+        touched += len * sizeof(float);
+    }
+    return touched;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Dirty-Range Transfer Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    if (!g_backend || !g_memory_manager) {
+        std::cerr << "Parallax runtime not initialized" << std::endl;
+        return 1;
+    }
+    
+    const size_t N = 100'000'000;  // 400 MB
+    parallax::KernelLauncher launcher(g_backend.get(), g_memory_manager.get());
+    auto loaded = parallax::samples::preload(launcher, {
+        {"vector_multiply", parallax::shaders::VECTOR_MULTIPLY_SPV, parallax::shaders::VECTOR_MULTIPLY_SPV_SIZE}});
+    if (!parallax::samples::all_loaded(loaded)) {
+        std::cerr << "Failed to load kernel" << std::endl;
+        return 1;
+    }
+    
+    // The explicit case gets its own buffer when implicit tracking can be
+    // turned off; otherwise both cases share one
+    const bool separate = parallax::samples::has_explicit_dirty() && parallax::samples::kMemExplicitDirty.supported;
+    float* data = (float*)parallax_umalloc(N * sizeof(float), 0);
+    float* explicit_data = separate
+        ? (float*)parallax_umalloc(N * sizeof(float), parallax::samples::kMemExplicitDirty.flags) : data;
+    if (!data || !explicit_data) {
+        std::cerr << "Failed to allocate memory" << std::endl;
+        if (data) parallax_ufree(data);
+        return 1;
+    }
+    for (size_t i = 0; i < N; i++) data[i] = explicit_data[i] = static_cast<float>(i % 1000);
+    
+    // Multiplier 1.0 leaves values unchanged, so only coherence traffic varies
+    auto launch = [&](float* buffer) { return launcher.launch("vector_multiply", buffer, N, 1.0f); };
+    auto clean_launch = [&](float* buffer) {
+        launch(buffer);  // Make the device copy current
+        auto start = std::chrono::high_resolution_clock::now();
+        launch(buffer);
+        return elapsed_ms(start);
+    };
+    
+    if (separate) {
+        // Nothing is tracked implicitly, so the initial contents go up explicitly
+        parallax::samples::DirtyRangeSet all(explicit_data, N * sizeof(float));
+        all.mark(explicit_data, N * sizeof(float));
+        all.flush();
+    }
+    double clean_ms = clean_launch(data);
+    double explicit_clean_ms = separate ? clean_launch(explicit_data) : clean_ms;
+    
+    parallax::samples::DirtyRangeSet tracker(explicit_data, N * sizeof(float));
+    std::cout << "Buffer: " << N * sizeof(float) / (1 << 20) << " MiB, tracking block "
+              << tracker.block_size() / 1024 << " KiB" << std::endl;
+    std::cout << "Clean launch: " << std::fixed << std::setprecision(3) << clean_ms << " ms" << std::endl;
+    std::cout << "Explicit marking: ";
+    if (!parallax::samples::has_explicit_dirty()) {
+        std::cout << "unavailable in this runtime";
+    } else if (separate) {
+        std::cout << "parallax_umark_dirty on a PARALLAX_MEM_EXPLICIT_DIRTY buffer (clean launch "
+                  << explicit_clean_ms << " ms)";
+    } else {
+        std::cout << "parallax_umark_dirty on the same buffer. PARALLAX_MEM_EXPLICIT_DIRTY is not" << std::endl
+                  << "  defined, so the explicit column includes the implicit tracking cost too (see Expl - impl)";
+    }
+    std::cout << std::endl << std::endl;
+    
+    std::cout << std::left << std::setw(10) << "Dirty"
+              << std::setw(14) << "Bytes"
+              << std::setw(16) << "Implicit (ms)"
+              << std::setw(16) << "Explicit (ms)"
+              << std::setw(10) << "Ranges"
+              << std::setw(18) << "Impl over clean"
+              << (separate ? "Expl over clean" : "Expl - impl") << std::endl;
+    std::cout << std::string(96, '-') << std::endl;
+    
+    const double fractions[] = {0.0001, 0.001, 0.01, 0.1, 1.0};
+    bool ok = true;
+    for (double f : fractions) {
+        size_t bytes = touch_fraction(data, N, f, nullptr);
+        auto start = std::chrono::high_resolution_clock::now();
+        ok = launch(data) && ok;
+        double implicit_ms = elapsed_ms(start);
+        
+        double explicit_ms = -1.0;
+        size_t ranges = 0;
+        if (parallax::samples::has_explicit_dirty()) {
+            touch_fraction(explicit_data, N, f, &tracker);
+            ranges = tracker.range_count();
+            start = std::chrono::high_resolution_clock::now();
+            tracker.flush();
+            ok = launch(explicit_data) && ok;
+            explicit_ms = elapsed_ms(start);
+        }
+        
+        std::cout << std::left << std::setw(10) << (std::to_string(f * 100.0).substr(0, 5) + "%")
+                  << std::setw(14) << bytes
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(16) << implicit_ms;
+        if (explicit_ms >= 0.0) std::cout << std::setw(16) << explicit_ms << std::setw(10) << ranges;
+        else std::cout << std::setw(16) << "n/a" << std::setw(10) << "-";
+        std::cout << std::setw(15) << implicit_ms - clean_ms << " ms";
+        if (explicit_ms >= 0.0) {
+            double extra = separate ? explicit_ms - explicit_clean_ms : explicit_ms - implicit_ms;
+            std::cout << std::setw(12) << extra << " ms";
+        }
+        std::cout << std::endl;
+    }
+    
+    if (separate) parallax_ufree(explicit_data);
+    parallax_ufree(data);
+    
+    std::cout << std::endl;
+    std::cout << "Overhead that stays flat as the dirty fraction drops means the" << std::endl;
+    std::cout << "whole buffer is being retransferred." << std::endl;
+    parallax::samples::print_metrics();
+    
+    return ok ? 0 : 1;
+}
@@ -1,6 +1,8 @@
 #include <parallax/runtime.h>
 #include <parallax/kernel_launcher.hpp>
 #include <parallax/shaders/vector_multiply.hpp>
+#include "common/metrics.hpp"
+#include "common/trace.hpp"
 #include <iostream>
 #include <vector>
 #include <chrono>
@@ -68,19 +70,21 @@ int main() {
         return 1;
     }
     
-    auto gpu_start = std::chrono::high_resolution_clock::now();
-    
-    // Launch kernel
-    if (!launcher.launch("vector_multiply", data, N, multiplier)) {
+    // Launch kernel, split into phases (PARALLAX_TRACE=file.json exports them)
+    auto stats = parallax::samples::profile_launch(launcher, "vector_multiply", data, N, multiplier, 1.0f);
+    if (!stats.ok) {
         std::cerr << "Failed to launch kernel" << std::endl;
         parallax_ufree(data);
         return 1;
     }
     
-    auto gpu_end = std::chrono::high_resolution_clock::now();
-    auto gpu_time = std::chrono::duration_cast<std::chrono::microseconds>(gpu_end - gpu_start).count();
+    auto gpu_time = static_cast<long long>(stats.total_ms * 1000.0);
     
     std::cout << "GPU time: " << gpu_time / 1000.0 << " ms" << std::endl;
+    std::cout << "  upload:   " << stats.upload_ms << " ms (" << stats.upload_bytes / (1 << 20) << " MiB)" << std::endl;
+    std::cout << "  dispatch: " << stats.dispatch_ms << " ms" << std::endl;
+    std::cout << "  overhead: " << stats.overhead_ms << " ms (record + submit + queue wait; not separable)" << std::endl;
+    std::cout << "  download: " << stats.download_ms << " ms (" << stats.download_bytes / (1 << 20) << " MiB)" << std::endl;
     
     // Verify results
     std::cout << "\nVerifying results..." << std::endl;
@@ -110,6 +114,7 @@ int main() {
     
     // Cleanup
     parallax_ufree(data);
+    parallax::samples::print_metrics();
     
     std::cout << "\n==================================" << std::endl;
     std::cout << "Test complete!" << std::endl;
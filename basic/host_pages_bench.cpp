@@ -0,0 +1,173 @@
+/**
+ * @file host_pages_bench.cpp
+ * @brief Host init, random access and GPU transfer on 4K vs 2M pages, with and without NUMA binding
+ *
+ * One 100M-float buffer per configuration, mapped by HostPages:
+ *
+ *   host_touch   parallel first-touch init of a fresh mapping (page faults
+ *                and zeroing; one fault per 2 MB instead of per 4 KB)
+ *   host_gather  parallel strided-permutation reads of the warm buffer, where
+ *                4 KB pages miss the TLB on nearly every access
+ *   transfer     the buffer imported with HostRange and doubled by one
+ *                std::transform(par); zero copy when the runtime has
+ *                parallax_uimport, otherwise a staged copy (reported)
+ *
+ * Variants: 4k, 2mT (transparent), 2mE (explicit hugetlbfs; needs
+ * vm.nr_hugepages >= 200), each also with an N suffix when bound to the
+ * GPU's NUMA node, which only runs on multi-node hosts where the node of
+ * the GPU's PCIe root is known. Speedup is against 4k.
+ *
+ * Usage: host_pages_bench [--elements N] [harness flags]
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/device_info.hpp"
+#include "common/host_import.hpp"
+#include "common/host_pages.hpp"
+#include "common/host_parallel.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <execution>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::HostPages;
+using parallax::samples::HostRange;
+using parallax::samples::PageMode;
+using parallax::samples::Work;
+
+static float init_value(size_t i) { return static_cast<float>(i % 1024); }
+
+static void parallel_init(float* p, size_t n) {
+    parallax::samples::host_parallel_blocks(n, [p](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) p[i] = init_value(i);
+    });
+}
+
+// Visits every element once in an order that jumps ~4 MB between reads
+static double parallel_gather(const float* p, size_t n) {
+    const size_t stride = 1000003;  // Prime, so i * stride % n is a permutation unless n is a multiple
+    std::mutex lock;
+    double total = 0.0;
+    parallax::samples::host_parallel_blocks(n, [&](size_t begin, size_t end) {
+        double sum = 0.0;
+        for (size_t i = begin; i < end; i++) sum += p[(i * stride) % n];
+        std::lock_guard<std::mutex> guard(lock);
+        total += sum;
+    });
+    return total;
+}
+
+struct Config {
+    std::string variant;
+    PageMode mode;
+    int node;
+};
+
+static bool bench_config(BenchHarness& h, const Config& c, size_t n) {
+    const size_t bytes = n * sizeof(float);
+    
+    // First touch: a fresh mapping per run, created untimed
+    std::unique_ptr<HostPages> fresh;
+    auto touch = h.measure([&] { fresh.reset(); fresh = std::make_unique<HostPages>(bytes, c.mode, c.node); },
+                           [&] { if (fresh->ok()) parallel_init(fresh->as<float>(), n); }, 5);
+    if (!fresh || !fresh->ok()) {
+        std::cerr << "Failed to map " << bytes << " bytes for " << c.variant << std::endl;
+        return false;
+    }
+    std::cout << "    " << c.variant << ": " << page_mode_name(fresh->mode())
+              << (fresh->numa_node() >= 0 ? ", node " + std::to_string(fresh->numa_node()) : std::string())
+              << std::endl;
+    bool touched = true;
+    for (size_t i = 0; i < n && touched; i += 4093) touched = fresh->as<float>()[i] == init_value(i);
+    h.record("host_touch", c.variant, n, touch, Work{static_cast<double>(bytes), 0.0}, touched);
+    
+    const float* data = fresh->as<float>();
+    double expected = 0.0;
+    for (size_t i = 0; i < n; i++) expected += init_value(i);
+    double sum = 0.0;
+    auto gather = h.measure([&] { sum = parallel_gather(data, n); }, 5);
+    h.record("host_gather", c.variant, n, gather, Work{static_cast<double>(bytes), static_cast<double>(n)},
+             sum == expected);
+    
+    HostRange range(fresh->data(), bytes, true);
+    if (!range.data()) {
+        std::cerr << "HostRange failed for " << c.variant << std::endl;
+        return false;
+    }
+    float* d = range.as<float>();
+    auto transfer = h.measure([&] { parallel_init(d, n); }, [&] {
+        std::transform(std::execution::par, d, d + n, d, [](float v) { return v * 2.0f; });
+    }, 5);
+    range.commit();
+    bool doubled = true;
+    for (size_t i = 0; i < n && doubled; i += 4093) doubled = fresh->as<float>()[i] == 2.0f * init_value(i);
+    h.record("transfer", c.variant, n, transfer, Work{2.0 * bytes, static_cast<double>(n)}, doubled);
+    if (!range.zero_copy()) std::cout << "    transfer: " << parallax::samples::mode_name(range.mode()) << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Host Pages & NUMA Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    size_t n = 100000000;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--elements") == 0) n = std::max<size_t>(1024, std::strtoull(argv[i + 1], nullptr, 10));
+    }
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    const auto device = parallax::samples::primary_device();
+    const int nodes = parallax::samples::numa_node_count();
+    const int gpu_node = parallax::samples::device_numa_node(device);
+    const std::string thp = parallax::samples::thp_setting();
+    std::cout << "GPU: " << device.name;
+    if (device.has_pci) std::cout << " (" << device.pci_address() << ")";
+    std::cout << std::endl;
+    std::cout << "NUMA nodes: " << nodes << ", GPU node: " << (gpu_node >= 0 ? std::to_string(gpu_node) : "unknown")
+              << std::endl;
+    std::cout << "Transparent huge pages: " << (thp.empty() ? "unavailable" : thp) << std::endl;
+    std::cout << std::endl;
+    
+    std::vector<Config> configs = {
+        {"4k", PageMode::Default, -1},
+        {"2mT", PageMode::Transparent, -1},
+        {"2mE", PageMode::Explicit, -1},
+    };
+    if (nodes > 1 && gpu_node >= 0) {
+        for (size_t i = 0, count = configs.size(); i < count; i++) {
+            configs.push_back({configs[i].variant + "N", configs[i].mode, gpu_node});
+        }
+    } else {
+        std::cout << "Single NUMA node or unknown GPU node: binding variants skipped" << std::endl;
+    }
+    
+    BenchHarness h("host_pages_bench", parallax::samples::BenchOptions::parse(argc, argv), device.name);
+    h.print_header();
+    
+    bool ok = true;
+    for (const auto& c : configs) ok = bench_config(h, c, n) && ok;
+    
+    std::cout << std::endl;
+    std::cout << "2mE falls back to transparent pages when the hugetlbfs pool is empty "
+              << "(see the mapping line above each group)" << std::endl;
+    
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return ok ? status : 1;
+}
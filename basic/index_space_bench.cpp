@@ -0,0 +1,170 @@
+/**
+ * @file index_space_bench.cpp
+ * @brief Counting iterators and index domains vs a materialized index buffer
+ *
+ * Kernels that need their index used to iterate an iota array, which has to
+ * be allocated, filled on the host and uploaded before the first launch,
+ * then read back by every invocation. Here the same lambdas run three ways:
+ *
+ *   iota_alloc   parallax_umalloc + std::iota + launch + free per call,
+ *                the pattern when the index buffer is built where it is used
+ *   iota_buffer  one prebuilt uint32_t index buffer, reused across calls
+ *   counting     index_begin(0)..index_begin(n): the index comes from the
+ *                invocation id, nothing is allocated
+ *
+ * plus a 2D 5-point Laplacian over a frame's interior, iterating a buffer of
+ * interior cell indices (iota_2d) vs an index_domain_2d (domain_2d). Work
+ * counts only the data arrays, so the index traffic shows up as lower GB/s.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/index_range.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+using parallax::samples::index_begin;
+using parallax::samples::index_domain_2d;
+
+// Clamped central difference: needs i to reach both neighbours
+static auto central_diff(const float* in, float* out, size_t n) {
+    return [=](size_t i) {
+        size_t lo = i == 0 ? 0 : i - 1, hi = i + 1 < n ? i + 1 : i;
+        out[i] = 0.5f * (in[hi] - in[lo]);
+    };
+}
+
+static bool same(const float* a, const float* b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (std::abs(a[i] - b[i]) > 1e-6f) return false;
+    }
+    return true;
+}
+
+static bool bench_1d(BenchHarness& h, size_t n) {
+    float* in = (float*)parallax_umalloc(n * sizeof(float), 0);
+    float* out = (float*)parallax_umalloc(n * sizeof(float), 0);
+    uint32_t* idx = (uint32_t*)parallax_umalloc(n * sizeof(uint32_t), 0);
+    if (!in || !out || !idx) {
+        std::cerr << "Failed to allocate " << n << " elements" << std::endl;
+        if (in) parallax_ufree(in);
+        if (out) parallax_ufree(out);
+        if (idx) parallax_ufree(idx);
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) in[i] = static_cast<float>(i % 1000) * 0.01f;
+    std::iota(idx, idx + n, 0u);
+    std::vector<float> expected(n);
+    auto reference = central_diff(in, expected.data(), n);
+    for (size_t i = 0; i < n; i++) reference(i);
+    Work work{2.0 * n * sizeof(float), 2.0 * n};
+    
+    auto alloc = h.measure([&] {
+        uint32_t* tmp = (uint32_t*)parallax_umalloc(n * sizeof(uint32_t), 0);
+        if (!tmp) return;
+        std::iota(tmp, tmp + n, 0u);
+        std::for_each(std::execution::par, tmp, tmp + n, central_diff(in, out, n));
+        parallax_ufree(tmp);
+    }, 5);
+    h.record("iota_alloc", "gpu", n, alloc, work, same(expected.data(), out, n));
+    
+    std::fill(out, out + n, 0.0f);
+    auto buffer = h.measure([&] {
+        std::for_each(std::execution::par, idx, idx + n, central_diff(in, out, n));
+    }, 5);
+    h.record("iota_buffer", "gpu", n, buffer, work, same(expected.data(), out, n));
+    
+    std::fill(out, out + n, 0.0f);
+    auto counting = h.measure([&] {
+        std::for_each(std::execution::par, index_begin(0), index_begin(n), central_diff(in, out, n));
+    }, 5);
+    h.record("counting", "gpu", n, counting, work, same(expected.data(), out, n));
+    
+    parallax_ufree(in);
+    parallax_ufree(out);
+    parallax_ufree(idx);
+    return true;
+}
+
+static bool bench_2d(BenchHarness& h, size_t nx, size_t ny) {
+    const size_t cells = nx * ny;
+    const index_domain_2d interior(nx - 2, ny - 2, 1, 1);
+    float* in = (float*)parallax_umalloc(cells * sizeof(float), 0);
+    float* out = (float*)parallax_umalloc(cells * sizeof(float), 0);
+    uint32_t* idx = (uint32_t*)parallax_umalloc(interior.size() * sizeof(uint32_t), 0);
+    if (!in || !out || !idx) {
+        std::cerr << "Failed to allocate " << nx << "x" << ny << " frame" << std::endl;
+        if (in) parallax_ufree(in);
+        if (out) parallax_ufree(out);
+        if (idx) parallax_ufree(idx);
+        return false;
+    }
+    for (size_t i = 0; i < cells; i++) in[i] = static_cast<float>((i * 7) % 255) / 255.0f;
+    std::fill(out, out + cells, 0.0f);
+    for (size_t k = 0; k < interior.size(); k++) {
+        idx[k] = static_cast<uint32_t>((k / interior.nx + 1) * nx + (k % interior.nx + 1));
+    }
+    auto laplacian = [=](size_t c) {
+        out[c] = in[c - 1] + in[c + 1] + in[c - nx] + in[c + nx] - 4.0f * in[c];
+    };
+    std::vector<float> expected(cells, 0.0f);
+    for (size_t k = 0; k < interior.size(); k++) {
+        size_t c = idx[k];
+        expected[c] = in[c - 1] + in[c + 1] + in[c - nx] + in[c + nx] - 4.0f * in[c];
+    }
+    Work work{2.0 * interior.size() * sizeof(float), 5.0 * interior.size()};
+    
+    auto buffer = h.measure([&] {
+        std::for_each(std::execution::par, idx, idx + interior.size(), laplacian);
+    }, 5);
+    h.record("iota_2d", "gpu", cells, buffer, work, same(expected.data(), out, cells));
+    
+    std::fill(out, out + cells, 0.0f);
+    auto domain = h.measure([&] {
+        std::for_each(std::execution::par, interior.begin(), interior.end(),
+                      interior.unflatten([=](size_t x, size_t y) { laplacian(y * nx + x); }));
+    }, 5);
+    h.record("domain_2d", "gpu", cells, domain, work, same(expected.data(), out, cells));
+    
+    parallax_ufree(in);
+    parallax_ufree(out);
+    parallax_ufree(idx);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Index-Space Iteration Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    BenchHarness h("index_space_bench", parallax::samples::BenchOptions::parse(argc, argv));
+    h.print_header();
+    
+    bool ok = true;
+    for (size_t n : {size_t(1000000), size_t(16000000), size_t(100000000)}) ok = bench_1d(h, n) && ok;
+    ok = bench_2d(h, 4096, 4096) && ok;
+    
+    std::cout << std::endl;
+    std::cout << "iota rows read 4 extra bytes of index per element (400 MB at 100M); "
+              << "counting and domain rows allocate none" << std::endl;
+    
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return ok ? status : 1;
+}
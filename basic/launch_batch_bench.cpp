@@ -0,0 +1,127 @@
+/**
+ * @file launch_batch_bench.cpp
+ * @brief A launch sequence as one async job vs eager launches, where overhead dominates
+ *
+ * One iteration is an 8-launch sequence over two small buffers, each
+ * multiplied by 2 and then by 0.5, so the data is unchanged and the loop
+ * can repeat indefinitely.
+ * "eager" is the plain loop: one synchronous launch per step on the
+ * calling thread. "async" issues one launch_async per step and waits on
+ * every event; "batch" builds the sequence once as a LaunchBatch and
+ * submits it as one job per iteration. All three issue the same GPU
+ * launches. Speedups are against "eager"; batch only saves the per-launch
+ * handoff that "async" pays, so if it cannot beat "eager" the run says so.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/kernel_launcher.hpp>
+#include <parallax/shaders/vector_multiply.hpp>
+#include "common/async_launcher.hpp"
+#include "common/bench_harness.hpp"
+#include "common/kernel_preload.hpp"
+#include "common/launch_batch.hpp"
+#include <iostream>
+#include <vector>
+
+extern std::unique_ptr<parallax::VulkanBackend> g_backend;
+extern std::unique_ptr<parallax::MemoryManager> g_memory_manager;
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Launch Batch Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    if (!g_backend || !g_memory_manager) {
+        std::cerr << "Parallax runtime not initialized" << std::endl;
+        return 1;
+    }
+    
+    parallax::KernelLauncher launcher(g_backend.get(), g_memory_manager.get());
+    auto loaded = parallax::samples::preload(launcher, {
+        {"vector_multiply", parallax::shaders::VECTOR_MULTIPLY_SPV, parallax::shaders::VECTOR_MULTIPLY_SPV_SIZE}});
+    if (!parallax::samples::all_loaded(loaded)) {
+        std::cerr << "Failed to load kernel" << std::endl;
+        return 1;
+    }
+    
+    parallax::samples::BenchHarness h("launch_batch_bench", parallax::samples::BenchOptions::parse(argc, argv));
+    h.print_header();
+    
+    const int reps = 500;
+    bool all_ok = true;
+    std::vector<size_t> batch_slower;
+    
+    for (size_t N : {size_t(10240), size_t(102400)}) {
+        float* a = (float*)parallax_umalloc(N * sizeof(float), 0);
+        float* b = (float*)parallax_umalloc(N * sizeof(float), 0);
+        if (!a || !b) {
+            std::cerr << "Failed to allocate " << N << " floats" << std::endl;
+            if (a) parallax_ufree(a);
+            if (b) parallax_ufree(b);
+            return 1;
+        }
+        for (size_t i = 0; i < N; i++) a[i] = b[i] = static_cast<float>(i % 1000);
+        
+        struct Step { float* data; float arg; };
+        const std::vector<Step> steps = {{a, 2.0f}, {b, 2.0f}, {a, 0.5f}, {b, 0.5f},
+                                         {a, 2.0f}, {b, 2.0f}, {a, 0.5f}, {b, 0.5f}};
+        
+        parallax::samples::LaunchBatch batch;
+        for (const Step& s : steps) batch.launch("vector_multiply", s.data, N, s.arg);
+        
+        bool ok = true;
+        // Per run: the kernel reads and writes every element of each launch
+        parallax::samples::Work work{2.0 * sizeof(float) * N * steps.size(),
+                                     static_cast<double>(N) * steps.size()};
+        
+        parallax::samples::Summary eager, async_eager, async_batch;
+        eager = h.measure([&] {
+            for (const Step& s : steps) {
+                ok = parallax::samples::counted_launch(launcher, "vector_multiply", s.data, N, s.arg) && ok;
+            }
+        }, reps);
+        {
+            parallax::samples::AsyncLauncher async(launcher);
+            std::vector<parallax::samples::LaunchEvent> events;
+            events.reserve(steps.size());
+            async_eager = h.measure([&] {
+                events.clear();
+                for (const Step& s : steps) events.push_back(async.launch_async("vector_multiply", s.data, N, s.arg));
+                for (const auto& event : events) ok = event.wait() && ok;
+            }, reps);
+            async_batch = h.measure([&] { ok = batch.submit(async).wait() && ok; }, reps);
+        }
+        
+        // x2 then x0.5 is exact, so both buffers must still hold the input
+        for (size_t i = 0; i < N && ok; i++) {
+            float expected = static_cast<float>(i % 1000);
+            if (a[i] != expected || b[i] != expected) ok = false;
+        }
+        all_ok = all_ok && ok;
+        
+        h.record("launch_seq", "eager", N, eager, work, ok);
+        h.record("launch_seq", "async", N, async_eager, work, ok);
+        h.record("launch_seq", "batch", N, async_batch, work, ok);
+        if (async_batch.median_ms >= eager.median_ms) batch_slower.push_back(N);
+        
+        parallax_ufree(a);
+        parallax_ufree(b);
+    }
+    
+    std::cout << std::endl;
+    std::cout << "Times are per iteration (8 launches)." << std::endl;
+    for (size_t N : batch_slower) {
+        std::cout << "Note: batch does not beat eager launches at " << N
+                  << " elements; it only hides the async handoff, and each step is still a full launch"
+                  << std::endl;
+    }
+    
+    std::cout << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Benchmark Complete!" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    int status = h.finish();
+    return all_ok ? status : 1;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file multi_gpu_bench.cpp
+ * @brief Scaling of one vector_multiply across 1, 2 and 4 GPUs
+ *
+ * Runs the comprehensive_bench size sweep with the launch split across the
+ * first 1, 2 and 4 lanes of a MultiDevice, weighted by each GPU's measured
+ * throughput. Speedup is relative to the single-GPU row. Lane counts above
+ * what the runtime exposes are skipped.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/kernel_launcher.hpp>
+#include <parallax/shaders/vector_multiply.hpp>
+#include "common/bench_harness.hpp"
+#include "common/multi_device.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <numeric>
+#include <string>
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Multi-GPU Scaling Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    parallax::samples::MultiDevice devices;
+    if (devices.size() == 0) {
+        std::cerr << "Parallax runtime not initialized" << std::endl;
+        return 1;
+    }
+    if (!devices.preload({{"vector_multiply", parallax::shaders::VECTOR_MULTIPLY_SPV,
+                           parallax::shaders::VECTOR_MULTIPLY_SPV_SIZE}}) ||
+        !devices.calibrate("vector_multiply", 1.0f)) {
+        std::cerr << "Failed to load or calibrate kernel" << std::endl;
+        return 1;
+    }
+    
+    for (const auto& lane : devices.lanes()) {
+        std::cout << "GPU " << lane.device << ": " << lane.info.name << ", "
+                  << std::fixed << std::setprecision(1) << lane.elements_per_ms / 1000.0
+                  << " M elements/ms" << std::endl;
+    }
+#ifndef PARALLAX_HAS_DEVICE_BACKENDS
+    std::cout << "Runtime exposes only the global backend; multi-GPU rows are skipped" << std::endl;
+#endif
+    std::cout << std::endl;
+    
+    parallax::samples::BenchHarness h("multi_gpu_bench", parallax::samples::BenchOptions::parse(argc, argv),
+                                      devices.lanes()[0].info.name);
+    h.print_header();
+    
+    // Same sweep as comprehensive_bench
+    const std::vector<size_t> sizes = {1024, 10240, 102400, 1024000, 10240000, 102400000};
+    const size_t lane_counts[] = {1, 2, 4};
+    const float multiplier = 2.0f;
+    
+    for (size_t N : sizes) {
+        float* data = (float*)parallax_umalloc(N * sizeof(float), 0);
+        if (!data) {
+            std::cerr << "Failed to allocate " << N << " floats" << std::endl;
+            // Failed rows, so finish() and --compare see the size too
+            for (size_t lanes : lane_counts) {
+                if (lanes <= devices.size()) h.record("vector_multiply", std::to_string(lanes) + "gpu", N, {}, {}, false);
+            }
+            continue;
+        }
+        std::vector<float> input(N);
+        std::iota(input.begin(), input.end(), 0.0f);
+        
+        for (size_t lanes : lane_counts) {
+            if (lanes > devices.size()) continue;
+            
+            bool launched = true;
+            auto time = h.measure([&] { std::copy(input.begin(), input.end(), data); },
+                                  [&] { launched = devices.launch("vector_multiply", data, N, multiplier, lanes) && launched; },
+                                  N >= 100000000 ? 5 : 10);
+            
+            bool correct = launched;
+            for (size_t i = 0; i < N && correct; i += 97) {
+                if (data[i] != input[i] * multiplier) correct = false;
+            }
+            
+            // Checksum through the partitioned reduction: one partial per lane's
+            // slice, summed on the host (there is no reduction kernel to launch)
+            double sum = devices.reduce(N, 0.0, [&](const parallax::samples::DeviceLane&, size_t offset, size_t count) {
+                return std::reduce(std::execution::par, data + offset, data + offset + count, 0.0);
+            }, std::plus<double>(), lanes);
+            double expected = std::reduce(std::execution::par, input.begin(), input.end(), 0.0) * multiplier;
+            correct = correct && std::abs(sum - expected) <= 1e-6 * expected;
+            
+            h.record("vector_multiply", std::to_string(lanes) + "gpu", N, time,
+                     parallax::samples::Work{2.0 * sizeof(float) * N, static_cast<double>(N)}, correct);
+        }
+        parallax_ufree(data);
+    }
+    
+    std::cout << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Benchmark Complete!" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    return h.finish();
+}
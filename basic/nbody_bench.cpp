@@ -0,0 +1,155 @@
+/**
+ * @file nbody_bench.cpp
+ * @brief All-pairs N-body steps over AoS particles vs a soa_vector
+ *
+ * One step accumulates the softened gravitational acceleration of every
+ * particle from all others, updates velocities, then drifts positions.
+ * "aos" runs it over a unified Particle array: neighbouring invocations
+ * read x (or vx) 28 bytes apart. "soa" runs the same arithmetic over a
+ * soa_vector<Particle>, where each field is its own contiguous array and
+ * neighbouring invocations read neighbouring floats.
+ *
+ * Both sides start from the same state and perform identical operations,
+ * so their final positions are compared element by element.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/soa_vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+
+struct Particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+};
+
+using Particles = parallax::samples::soa_vector<Particle,
+    &Particle::x, &Particle::y, &Particle::z,
+    &Particle::vx, &Particle::vy, &Particle::vz, &Particle::mass>;
+
+constexpr float kDt = 0.01f;
+constexpr float kSoftening = 1e-3f;
+constexpr double kFlopsPerInteraction = 20.0;  // Conventional all-pairs count
+
+static std::vector<Particle> initial_state(size_t n) {
+    std::vector<Particle> particles(n);
+    uint32_t state = 12345u;
+    auto next = [&] {
+        state = state * 1664525u + 1013904223u;  // LCG: reproducible cloud
+        return static_cast<float>(state >> 8) / 8388608.0f - 1.0f;
+    };
+    for (auto& p : particles) p = {next(), next(), next(), 0.0f, 0.0f, 0.0f, 1.0f / static_cast<float>(n)};
+    return particles;
+}
+
+static void step_aos(Particle* particles, size_t n) {
+    std::for_each(std::execution::par, particles, particles + n, [=](Particle& p) {
+        float ax = 0.0f, ay = 0.0f, az = 0.0f;
+        for (size_t j = 0; j < n; j++) {
+            const Particle& q = particles[j];
+            float dx = q.x - p.x, dy = q.y - p.y, dz = q.z - p.z;
+            float inv = 1.0f / std::sqrt(dx * dx + dy * dy + dz * dz + kSoftening);
+            float s = q.mass * inv * inv * inv;
+            ax += s * dx; ay += s * dy; az += s * dz;
+        }
+        p.vx += kDt * ax; p.vy += kDt * ay; p.vz += kDt * az;
+    });
+    std::for_each(std::execution::par, particles, particles + n, [](Particle& p) {
+        p.x += kDt * p.vx; p.y += kDt * p.vy; p.z += kDt * p.vz;
+    });
+}
+
+static void step_soa(Particles& particles) {
+    const size_t n = particles.size();
+    const float* x = particles.field<&Particle::x>();
+    const float* y = particles.field<&Particle::y>();
+    const float* z = particles.field<&Particle::z>();
+    const float* mass = particles.field<&Particle::mass>();
+    std::for_each(std::execution::par, particles.begin(), particles.end(), [=](auto p) {
+        const size_t i = p.index();
+        float ax = 0.0f, ay = 0.0f, az = 0.0f;
+        for (size_t j = 0; j < n; j++) {
+            float dx = x[j] - x[i], dy = y[j] - y[i], dz = z[j] - z[i];
+            float inv = 1.0f / std::sqrt(dx * dx + dy * dy + dz * dz + kSoftening);
+            float s = mass[j] * inv * inv * inv;
+            ax += s * dx; ay += s * dy; az += s * dz;
+        }
+        p[&Particle::vx] += kDt * ax; p[&Particle::vy] += kDt * ay; p[&Particle::vz] += kDt * az;
+    });
+    std::for_each(std::execution::par, particles.begin(), particles.end(), [](auto p) {
+        p[&Particle::x] += kDt * p[&Particle::vx];
+        p[&Particle::y] += kDt * p[&Particle::vy];
+        p[&Particle::z] += kDt * p[&Particle::vz];
+    });
+}
+
+static bool same_positions(const Particle* aos, const Particles& soa) {
+    for (size_t i = 0; i < soa.size(); i++) {
+        Particle s = soa.load(i);
+        for (auto [a, b] : {std::pair{aos[i].x, s.x}, std::pair{aos[i].y, s.y}, std::pair{aos[i].z, s.z}}) {
+            if (std::abs(a - b) > 1e-4f * std::abs(a) + 1e-5f) return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax N-body Benchmark (AoS vs SoA)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    BenchHarness h("nbody_bench", parallax::samples::BenchOptions::parse(argc, argv));
+    h.print_header();
+    
+    const int steps = 4;
+    for (size_t n : {size_t(2048), size_t(8192)}) {
+        const std::vector<Particle> start = initial_state(n);
+        // Per interaction: x, y, z and mass of the other particle
+        Work work{steps * static_cast<double>(n) * n * 4 * sizeof(float),
+                  steps * static_cast<double>(n) * n * kFlopsPerInteraction};
+        
+        Particle* aos = (Particle*)parallax_umalloc(n * sizeof(Particle), 0);
+        if (!aos) {
+            std::cerr << "Failed to allocate " << n << " particles" << std::endl;
+            if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+            return 1;
+        }
+        auto aos_time = h.measure([&] { std::copy(start.begin(), start.end(), aos); },
+                                  [&] { for (int s = 0; s < steps; s++) step_aos(aos, n); }, 3);
+        
+        Particles soa(start.data(), n);
+        auto soa_time = h.measure([&] { for (size_t i = 0; i < n; i++) soa[i] = start[i]; },
+                                  [&] { for (int s = 0; s < steps; s++) step_soa(soa); }, 3);
+        
+        h.record("nbody", "aos", n, aos_time, work);
+        h.record("nbody", "soa", n, soa_time, work, same_positions(aos, soa));
+        parallax_ufree(aos);
+    }
+    
+    std::cout << std::endl;
+    std::cout << "Bytes per particle: AoS " << sizeof(Particle) << ", SoA "
+              << Particles::element_bytes() << " in " << Particles::field_count << " arrays" << std::endl;
+    
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return status;
+}
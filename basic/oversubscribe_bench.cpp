@@ -0,0 +1,146 @@
+/**
+ * @file oversubscribe_bench.cpp
+ * @brief Throughput as the unified working set grows past device memory
+ *
+ * Allocates 256 MB parallax_umalloc buffers until the live total reaches
+ * each step of 0.25x .. 2x the device's VRAM, and at every step times one
+ * pass of std::transform(par) over all of them. Below 1x every buffer can
+ * stay resident; above it each pass has to evict and re-upload, so the
+ * curve shows how gracefully the runtime pages (or where it stops).
+ *
+ * Per step the sample prints VK_EXT_memory_budget heap usage next to the
+ * budget; once the working set exceeds VRAM, usage pinned at the budget is
+ * the observable sign of eviction. An allocation failure ends the curve
+ * with the size it was reached at instead of ending the program.
+ *
+ * Needs host RAM for the whole working set (the host side of every
+ * unified buffer). Usage:
+ *   oversubscribe_bench [--max-ratio R] [--vram-gb N] [harness flags]
+ * --vram-gb overrides the detected size, e.g. to keep the run short.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/device_info.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <execution>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+
+constexpr size_t kBufferBytes = size_t(256) << 20;
+constexpr size_t kBufferFloats = kBufferBytes / sizeof(float);
+
+struct Step {
+    double ratio;
+    double gbps;
+    parallax::samples::MemoryBudget budget;
+};
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Oversubscription Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    double max_ratio = 2.0;
+    double vram_gb = 0.0;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--max-ratio") == 0) max_ratio = std::max(0.25, std::atof(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--vram-gb") == 0) vram_gb = std::atof(argv[i + 1]);
+    }
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    const auto device = parallax::samples::primary_device();
+    uint64_t vram = vram_gb > 0.0 ? static_cast<uint64_t>(vram_gb * (1ull << 30)) : device.device_local_bytes;
+    if (vram == 0) {
+        vram = 4ull << 30;
+        std::cout << "Device memory size unknown; assuming 4 GB (use --vram-gb)" << std::endl;
+    }
+    std::cout << "GPU: " << device.name << ", " << std::fixed << std::setprecision(2)
+              << vram / double(1ull << 30) << " GB device memory" << std::endl;
+    if (!parallax::samples::memory_budget(device).known) {
+        std::cout << "VK_EXT_memory_budget unavailable: heap usage not reported" << std::endl;
+    }
+    std::cout << std::endl;
+    
+    BenchHarness h("oversubscribe_bench", parallax::samples::BenchOptions::parse(argc, argv), device.name);
+    h.print_header();
+    
+    std::vector<float*> buffers;
+    std::vector<Step> curve;
+    bool ok = true;
+    int passes = 0;  // Every pass adds 1 to every element
+    for (double ratio = 0.25; ratio <= max_ratio + 1e-9; ratio += 0.25) {
+        const size_t target = static_cast<size_t>(ratio * vram / kBufferBytes + 0.5);
+        bool allocated = true;
+        while (buffers.size() < std::max<size_t>(target, 1)) {
+            float* b = (float*)parallax_umalloc(kBufferBytes, 0);
+            if (!b) {
+                allocated = false;
+                break;
+            }
+            std::fill(b, b + kBufferFloats, static_cast<float>(passes));
+            buffers.push_back(b);
+        }
+        if (!allocated) {
+            std::cout << "parallax_umalloc failed with " << buffers.size() * (kBufferBytes >> 20) << " MB live ("
+                      << std::setprecision(2) << buffers.size() * double(kBufferBytes) / vram
+                      << "x device memory); curve ends here" << std::endl;
+            break;
+        }
+        
+        auto pass = h.measure([&] {
+            for (float* b : buffers) {
+                std::transform(std::execution::par, b, b + kBufferFloats, b, [](float v) { return v + 1.0f; });
+            }
+            passes++;
+        }, 3);
+        // New buffers start at the pass count so far, so every element ends at passes
+        bool correct = true;
+        for (float* b : buffers) {
+            for (size_t i = 0; i < kBufferFloats && correct; i += 65521) correct = b[i] == static_cast<float>(passes);
+        }
+        const double bytes = 2.0 * buffers.size() * kBufferBytes;
+        const auto& r = h.record("oversub", "gpu", buffers.size() * kBufferFloats, pass, Work{bytes, bytes / 8.0},
+                                 correct);
+        ok = ok && correct;
+        
+        Step step{ratio, r.gbps(), parallax::samples::memory_budget(device)};
+        std::cout << "    " << std::setprecision(2) << ratio << "x VRAM";
+        if (step.budget.known) {
+            std::cout << ", heap usage " << step.budget.usage_bytes / double(1ull << 30) << " / "
+                      << step.budget.budget_bytes / double(1ull << 30) << " GB";
+        }
+        std::cout << std::endl;
+        curve.push_back(step);
+    }
+    
+    if (!curve.empty()) {
+        std::cout << std::endl;
+        std::cout << "Degradation vs the smallest working set:" << std::endl;
+        std::cout << std::right << std::setw(10) << "Ratio" << std::setw(12) << "GB/s" << std::setw(12) << "Relative" << std::endl;
+        for (const auto& s : curve) {
+            std::cout << std::setw(9) << std::setprecision(2) << s.ratio << "x" << std::setw(12) << s.gbps
+                      << std::setw(11) << std::setprecision(1) << 100.0 * s.gbps / curve.front().gbps << "%"
+                      << std::endl;
+        }
+    }
+    
+    for (float* b : buffers) parallax_ufree(b);
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return ok ? status : 1;
+}
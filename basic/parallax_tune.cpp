@@ -0,0 +1,143 @@
+/**
+ * @file parallax_tune.cpp
+ * @brief Pre-tune the workgroup size of every manifest kernel for this GPU
+ *
+ * Compiles every PARALLAX_PRECOMPILE entry through the kernel cache,
+ * together with the built-in vector_multiply shader and any SPIR-V modules
+ * named on the command line, and runs AutoTuner on each. Choices land in
+ * the cache directory, and preload() applies them. preload() would tune
+ * a kernel on its first use anyway; running this ahead of time keeps the
+ * sweep out of the samples' startup. Running it again reports the cached
+ * choices; --retune measures afresh (e.g. after
+ * a driver update that did not change the device key).
+ *
+ * Usage: parallax_tune [--elements N] [--retune] [--spirv FILE.spv ...]
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/kernel_launcher.hpp>
+#include <parallax/lambda_compiler.hpp>
+#include <parallax/shaders/vector_multiply.hpp>
+#include "common/autotune.hpp"
+#include "common/compile_service.hpp"
+#include "common/device_info.hpp"
+#include "common/kernel_cache.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// The element-wise bodies the benchmarks offload
+PARALLAX_PRECOMPILE(scale_add, [](float& x) { x = x * 2.0f + 1.0f; });
+PARALLAX_PRECOMPILE(square, [](float& x) { x = x * x; });
+PARALLAX_PRECOMPILE(relu, [](float& x) { x = x > 0.0f ? x : 0.0f; });
+PARALLAX_PRECOMPILE(halve_offset, [](float& x) { x = 0.5f * x + 0.25f; });
+
+struct Kernel {
+    std::string name;
+    std::vector<uint32_t> spirv;
+};
+
+static std::vector<uint32_t> read_spirv(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return {};
+    const auto bytes = static_cast<size_t>(in.tellg());
+    std::vector<uint32_t> words(bytes / sizeof(uint32_t));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+    return in ? words : std::vector<uint32_t>{};
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Workgroup-Size Tuner" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    size_t elements = size_t(1) << 22;
+    bool retune = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--retune") == 0) retune = true;
+        else if (i + 1 < argc && std::strcmp(argv[i], "--elements") == 0)
+            elements = std::max<size_t>(4096, std::strtoull(argv[++i], nullptr, 10));
+        else if (i + 1 < argc && std::strcmp(argv[i], "--spirv") == 0) files.push_back(argv[++i]);
+    }
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (!backend || !memory) {
+        std::cerr << "Parallax runtime not initialized" << std::endl;
+        return 1;
+    }
+    
+    const auto device = parallax::samples::primary_device();
+    std::cout << "GPU: " << device.name << ", subgroup " << device.subgroup_size << ", max workgroup "
+              << device.max_workgroup_invocations << std::endl;
+    std::cout << "Candidates:";
+    for (uint32_t size : parallax::samples::local_size_candidates(device)) std::cout << " " << size;
+    std::cout << " (up to each kernel's generated size)" << std::endl;
+    
+    // Compile the manifest in the background while the built-ins load
+    parallax::samples::KernelCache cache(device.key());
+    parallax::samples::CompileService service(cache);
+    const auto entries = parallax::samples::CompileManifest::instance().entries();
+    service.submit(parallax::samples::CompileManifest::instance());
+    
+    std::vector<Kernel> kernels;
+    kernels.push_back({"vector_multiply", std::vector<uint32_t>(parallax::shaders::VECTOR_MULTIPLY_SPV,
+                        parallax::shaders::VECTOR_MULTIPLY_SPV + parallax::shaders::VECTOR_MULTIPLY_SPV_SIZE)});
+    bool ok = true;
+    for (const auto& path : files) {
+        auto words = read_spirv(path);
+        if (words.empty()) {
+            std::cerr << "Cannot read SPIR-V from " << path << std::endl;
+            ok = false;
+            continue;
+        }
+        kernels.push_back({std::filesystem::path(path).stem().string(), std::move(words)});
+    }
+    service.wait_all();
+    for (const auto& [name, job] : entries) {
+        auto handle = service.handle(name);
+        if (!handle.ok()) {
+            std::cerr << "Manifest kernel " << name << " did not compile" << std::endl;
+            ok = false;
+            continue;
+        }
+        kernels.push_back({name, handle.spirv()});
+    }
+    std::cout << kernels.size() << " kernels, " << elements << "-element probe" << std::endl;
+    std::cout << std::endl;
+    
+    parallax::KernelLauncher launcher(backend, memory);
+    parallax::samples::AutoTuner tuner(device);
+    std::cout << std::left << std::setw(20) << "Kernel" << std::right << std::setw(8) << "Local" << std::setw(8)
+              << "Tuned" << std::setw(8) << "El/inv" << std::setw(12) << "Default ms" << std::setw(12) << "Tuned ms"
+              << std::setw(9) << "Speedup" << "  Source" << std::endl;
+    for (const auto& k : kernels) {
+        auto r = tuner.load_tuned(launcher, k.name, k.spirv, elements, 1.0f, retune);
+        std::cout << std::left << std::setw(20) << k.name << std::right << std::setw(8) << r.default_local_size;
+        if (!r.ok()) {
+            std::cout << "  ✗ FAIL: could not load" << std::endl;
+            ok = false;
+            continue;
+        }
+        std::cout << std::setw(8) << r.local_size << std::setw(8) << r.elements_per_invocation << std::fixed
+                  << std::setprecision(3) << std::setw(12) << r.default_ms << std::setw(12) << r.best_ms
+                  << std::setprecision(2) << std::setw(8) << r.speedup() << "x  "
+                  << (r.cached ? "cached" : r.candidates ? "tuned" : "not tunable") << std::endl;
+    }
+    
+    std::cout << std::endl;
+    std::cout << "Choices saved to " << tuner.path().string() << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,43 @@
+# Compare the JIT and AOT builds of auto_lambda_bench: binary size and
+# time to the first offloaded result (auto_lambda_bench --startup).
+#
+#   cmake -DJIT=<path> -DAOT=<path> -P aot_compare.cmake
+
+foreach(mode JIT AOT)
+    if(NOT EXISTS "${${mode}}")
+        message(FATAL_ERROR "${mode} binary not found: ${${mode}}")
+    endif()
+endforeach()
+
+file(SIZE "${JIT}" jit_size)
+file(SIZE "${AOT}" aot_size)
+math(EXPR jit_kb "${jit_size} / 1024")
+math(EXPR aot_kb "${aot_size} / 1024")
+message("Binary size (KB): JIT ${jit_kb}, AOT ${aot_kb}")
+
+# Shared libraries count too: the JIT build also maps the plugin and LLVM
+find_program(LDD ldd)
+foreach(mode JIT AOT)
+    if(LDD)
+        execute_process(COMMAND ${LDD} "${${mode}}" OUTPUT_VARIABLE deps ERROR_QUIET)
+        string(REGEX MATCHALL "=> (/[^ ]+)" libs "${deps}")
+        set(lib_kb 0)
+        foreach(entry ${libs})
+            string(REGEX REPLACE "^=> " "" lib "${entry}")
+            if(EXISTS "${lib}")
+                file(SIZE "${lib}" bytes)
+                math(EXPR lib_kb "${lib_kb} + ${bytes} / 1024")
+            endif()
+        endforeach()
+        message("${mode} shared libraries (KB): ${lib_kb}")
+    endif()
+endforeach()
+
+foreach(mode JIT AOT)
+    message("")
+    message("== ${mode}: ${${mode}} --startup")
+    execute_process(COMMAND "${${mode}}" --startup RESULT_VARIABLE status)
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "${mode} startup run failed (${status})")
+    endif()
+endforeach()
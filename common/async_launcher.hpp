@@ -0,0 +1,198 @@
+/**
+ * @file async_launcher.hpp
+ * @brief Non-blocking kernel launches with wait/then chaining
+ *
+ * KernelLauncher::launch returns only after the GPU finishes. AsyncLauncher
+ * owns a submission thread that drives a KernelLauncher in FIFO order, the
+ * same ordering guarantee a single Vulkan queue gives. launch_async()
+ * returns a LaunchEvent immediately so the host can keep working, and
+ * then() appends dependent work that starts as soon as its predecessor
+ * completes, without a round trip through the calling thread.
+ *
+ * Only the submission thread touches the wrapped KernelLauncher, so it must
+ * not be used directly while an AsyncLauncher owns it.
+ */
+
+#pragma once
+
+#include <parallax/kernel_launcher.hpp>
+#include "common/metrics.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace parallax::samples {
+
+class AsyncLauncher;
+
+/// Completion handle for one submitted launch (cheap to copy).
+class LaunchEvent {
+public:
+    LaunchEvent() = default;
+
+    /// Block until the launch has finished; returns its success.
+    bool wait() const {
+        if (!state_) return false;
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->cv.wait(lock, [&] { return state_->done; });
+        return state_->ok;
+    }
+
+    bool ready() const {
+        if (!state_) return false;
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->done;
+    }
+
+    bool valid() const { return static_cast<bool>(state_); }
+
+    /// Run @p fn (returning bool) on the submission thread once this launch
+    /// succeeds. A failed predecessor fails the whole chain without calling
+    /// @p fn, and so does a default-constructed event, which has no
+    /// launcher to run on. The owning AsyncLauncher must outlive the chain.
+    template<typename Fn>
+    LaunchEvent then(Fn&& fn) const;
+
+    /// Chain another kernel launch on the same data.
+    LaunchEvent then_launch(std::string kernel, float* data, size_t n, float arg) const;
+
+private:
+    friend class AsyncLauncher;
+
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+        bool ok = false;
+    };
+
+    LaunchEvent(std::shared_ptr<State> state, AsyncLauncher* owner)
+        : state_(std::move(state)), owner_(owner) {}
+
+    // Already completed with failure
+    static LaunchEvent failed() {
+        LaunchEvent event(std::make_shared<State>(), nullptr);
+        event.complete(false);
+        return event;
+    }
+
+    void complete(bool ok) const {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->done = true;
+            state_->ok = ok;
+        }
+        state_->cv.notify_all();
+    }
+
+    std::shared_ptr<State> state_;
+    AsyncLauncher* owner_ = nullptr;
+};
+
+class AsyncLauncher {
+public:
+    explicit AsyncLauncher(KernelLauncher& launcher)
+        : launcher_(launcher), worker_([this] { run(); }) {}
+
+    ~AsyncLauncher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        worker_.join();
+    }
+
+    AsyncLauncher(const AsyncLauncher&) = delete;
+    AsyncLauncher& operator=(const AsyncLauncher&) = delete;
+
+    /// Queue a launch and return immediately.
+    LaunchEvent launch_async(std::string kernel, float* data, size_t n, float arg) {
+        return submit([this, kernel = std::move(kernel), data, n, arg] {
+            return counted_launch(launcher_, kernel, data, n, arg);
+        });
+    }
+
+    /// Queue arbitrary work that runs on the submission thread; @p fn
+    /// returns bool and may call the wrapped launcher.
+    template<typename Fn>
+    LaunchEvent submit(Fn&& fn) {
+        LaunchEvent event(std::make_shared<LaunchEvent::State>(), this);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back({std::function<bool()>(std::forward<Fn>(fn)), event});
+        }
+        cv_.notify_one();
+        return event;
+    }
+
+    /// Block until everything queued so far has completed.
+    bool synchronize() {
+        return submit([] { return true; }).wait();
+    }
+
+    KernelLauncher& launcher() { return launcher_; }
+
+private:
+    struct Job {
+        std::function<bool()> fn;
+        LaunchEvent event;
+    };
+
+    void run() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) return;  // stopping and drained
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            bool ok = false;
+            try {
+                ok = job.fn();
+            } catch (...) {
+                ok = false;
+            }
+            job.event.complete(ok);
+        }
+    }
+
+    KernelLauncher& launcher_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Job> queue_;
+    bool stopping_ = false;
+    std::thread worker_;  // Last: starts after the queue is constructed
+};
+
+template<typename Fn>
+LaunchEvent LaunchEvent::then(Fn&& fn) const {
+    if (!owner_) return failed();
+    // The queue is FIFO, so the predecessor has completed by the time this
+    // job runs; only its result needs checking.
+    auto prev = state_;
+    return owner_->submit([prev, fn = std::forward<Fn>(fn)]() mutable {
+        {
+            std::lock_guard<std::mutex> lock(prev->mutex);
+            if (!prev->ok) return false;
+        }
+        return static_cast<bool>(fn());
+    });
+}
+
+inline LaunchEvent LaunchEvent::then_launch(std::string kernel, float* data, size_t n, float arg) const {
+    AsyncLauncher* owner = owner_;
+    return then([owner, kernel = std::move(kernel), data, n, arg] {
+        return counted_launch(owner->launcher(), kernel, data, n, arg);
+    });
+}
+
+} // namespace parallax::samples
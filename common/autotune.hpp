@@ -0,0 +1,302 @@
+/**
+ * @file autotune.hpp
+ * @brief Per-device workgroup-size tuning of generated kernels, persisted in the cache
+ *
+ * The generator emits one LocalSize for every device, but the best one
+ * depends on the subgroup width (32 on NVIDIA, 64 on AMD GCN, 8-16 on
+ * Intel) and on occupancy limits. load_tuned() rewrites the module's
+ * LocalSize to each power of two from the subgroup width up to the
+ * generated size (and maxComputeWorkGroupInvocations, capped at 1024),
+ * times each variant over a probe buffer, and keeps the fastest one whose
+ * output matches the original. Larger sizes are never tried: the launcher
+ * sizes its group count for the generated LocalSize, so a larger group
+ * would run invocations past the end of the buffer, and the probe check
+ * only reads elements inside it. Variants are built in a scratch launcher that is destroyed
+ * when tuning ends, so only the chosen pipeline stays loaded. The choice
+ * is stored under the cache directory, keyed by device (DeviceInfo::key())
+ * and a hash of the SPIR-V, so a generator change re-tunes.
+ *
+ * load_choice() applies a stored choice without tuning. preload() goes
+ * through load_tuned(), so a kernel is tuned the first time any sample
+ * preloads it on a device, and later runs load the stored choice.
+ * parallax_tune does the same sweep ahead of time.
+ *
+ * A variant that computes the wrong result (e.g. because the launcher
+ * sizes its dispatch for the generated LocalSize) is never chosen. The
+ * elements each invocation handles are fixed by the generator; the result
+ * reports them (the widest vector access, from inspect_spirv()) so a
+ * vec4 kernel is visible next to its local size.
+ *
+ * Environment:
+ *   PARALLAX_CACHE_DIR  override the cache directory
+ *   PARALLAX_AUTOTUNE   0: preload() only applies stored choices, never tunes
+ */
+
+#pragma once
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/kernel_launcher.hpp>
+#include "common/cache_dir.hpp"
+#include "common/device_info.hpp"
+#include "common/spirv_inspect.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace parallax::samples {
+
+struct TuneResult {
+    std::string kernel;
+    uint32_t local_size = 0;               // Chosen (the generated size unless a variant won)
+    uint32_t default_local_size = 0;       // As generated
+    uint32_t elements_per_invocation = 1;  // Widest vector access
+    double best_ms = 0.0;
+    double default_ms = 0.0;
+    int candidates = 0;                    // Variants that ran and matched
+    bool cached = false;
+    bool loaded = false;                   // @p name is ready to launch
+
+    bool ok() const { return loaded; }
+    double speedup() const { return best_ms > 0.0 ? default_ms / best_ms : 1.0; }
+};
+
+/// False when PARALLAX_AUTOTUNE=0: kernels without a stored choice then
+/// load as generated instead of being tuned on first use.
+inline bool autotune_on_first_use() {
+    const char* env = std::getenv("PARALLAX_AUTOTUNE");
+    return !(env && std::string(env) == "0");
+}
+
+/// Powers of two from the subgroup width to the device's workgroup limit.
+inline std::vector<uint32_t> local_size_candidates(const DeviceInfo& device) {
+    const uint32_t width = device.subgroup_size ? device.subgroup_size : 32;
+    const uint32_t limit = std::min<uint32_t>(
+        device.max_workgroup_invocations ? device.max_workgroup_invocations : 256, 1024);
+    std::vector<uint32_t> sizes;
+    for (uint32_t size = width; size <= limit; size *= 2) sizes.push_back(size);
+    return sizes;
+}
+
+class AutoTuner {
+public:
+    /// @param backend, @p memory where tuning variants are built; without
+    ///        them load_tuned() loads kernels as generated
+    explicit AutoTuner(const DeviceInfo& device, std::filesystem::path dir = default_cache_dir(),
+                       VulkanBackend* backend = get_global_backend(),
+                       MemoryManager* memory = get_global_memory_manager())
+        : device_(device),
+          path_(dir / ("tune-" + std::to_string(fnv1a(device.key())) + ".txt")),
+          backend_(backend),
+          memory_(memory) {
+        load();
+    }
+
+    /// Load @p spirv into @p launcher as @p name with its tuned local size,
+    /// tuning first unless this device already has a choice for it.
+    /// @param elements probe size; @param arg launch argument that keeps
+    ///        values finite over repeated runs
+    TuneResult load_tuned(KernelLauncher& launcher, const std::string& name, const std::vector<uint32_t>& spirv,
+                          size_t elements = size_t(1) << 22, float arg = 1.0f, bool retune = false) {
+        if (!retune) {
+            TuneResult r = load_choice(launcher, name, spirv);
+            if (r.cached) return r;
+        }
+        TuneResult r = tune(launcher, name, spirv, elements, arg);
+        // Stored even when no variant ran, so the generated size is kept
+        // as the choice instead of re-sweeping on every first use
+        if (r.ok() && r.default_ms > 0.0) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                choices_[spirv_key(spirv)] = r;
+            }
+            save();
+        }
+        return r;
+    }
+
+    /// Load @p spirv as @p name with this device's stored choice (cached
+    /// set), or as generated when there is none. Never tunes.
+    TuneResult load_choice(KernelLauncher& launcher, const std::string& name, const std::vector<uint32_t>& spirv) {
+        TuneResult r;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = choices_.find(spirv_key(spirv));
+            // A choice above the generated size predates the cap in tune()
+            // and may write out of bounds; re-tune instead of applying it
+            if (it != choices_.end() && it->second.local_size <= it->second.default_local_size) r = it->second;
+        }
+        r.kernel = name;
+        r.cached = r.local_size != 0;
+        if (r.cached) {
+            r.loaded = load_variant(launcher, name, spirv, r.local_size, r.default_local_size);
+        } else {
+            r.local_size = r.default_local_size = inspect_spirv(spirv).local_size_x;
+            r.loaded = launcher.load_kernel(name, spirv.data(), spirv.size());
+        }
+        return r;
+    }
+
+    const DeviceInfo& device() const { return device_; }
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    static std::string spirv_key(const std::vector<uint32_t>& spirv) {
+        return std::to_string(fnv1a(spirv.data(), spirv.size() * sizeof(uint32_t)));
+    }
+
+    static bool load_variant(KernelLauncher& launcher, const std::string& name, const std::vector<uint32_t>& spirv,
+                             uint32_t local_size, uint32_t default_local_size) {
+        if (local_size == default_local_size) return launcher.load_kernel(name, spirv.data(), spirv.size());
+        std::vector<uint32_t> variant = with_local_size(spirv, local_size);
+        return !variant.empty() && launcher.load_kernel(name, variant.data(), variant.size());
+    }
+
+    TuneResult tune(KernelLauncher& launcher, const std::string& name, const std::vector<uint32_t>& spirv,
+                    size_t n, float arg) {
+        TuneResult r;
+        r.kernel = name;
+        const SpirvInfo info = inspect_spirv(spirv);
+        r.local_size = r.default_local_size = info.local_size_x;
+        r.elements_per_invocation = info.widest_vector;
+
+        // Variants live in their own launcher, so its destructor releases
+        // every pipeline but the chosen one, which is loaded into @p launcher
+        const std::string reference = name + "@default";
+        std::unique_ptr<KernelLauncher> scratch;
+        if (backend_ && memory_) scratch = std::make_unique<KernelLauncher>(backend_, memory_);
+        float* probe = scratch ? static_cast<float*>(parallax_umalloc(n * sizeof(float), 0)) : nullptr;
+        if (!probe || !scratch->load_kernel(reference, spirv.data(), spirv.size())) {
+            if (probe) parallax_ufree(probe);
+            r.loaded = launcher.load_kernel(name, spirv.data(), spirv.size());
+            return r;
+        }
+
+        // Small values keep multiply-add chains finite over the timed runs
+        std::vector<float> input(n), expected;
+        for (size_t i = 0; i < n; i++) input[i] = static_cast<float>(i % 64) / 64.0f;
+        auto run_once = [&](const std::string& kernel) {
+            std::copy(input.begin(), input.end(), probe);
+            return scratch->launch(kernel, probe, n, arg);
+        };
+        // Infinity if any timed launch fails, so that variant never wins
+        auto best_of = [&](const std::string& kernel) {
+            double best = std::numeric_limits<double>::infinity();
+            for (int rep = 0; rep < 3; rep++) {
+                auto start = std::chrono::high_resolution_clock::now();
+                bool ok = scratch->launch(kernel, probe, n, arg);
+                auto end = std::chrono::high_resolution_clock::now();
+                if (!ok) return std::numeric_limits<double>::infinity();
+                best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+            }
+            return best;
+        };
+        auto matches = [&] {
+            for (size_t i = 0; i < n; i += 997) {
+                const float want = expected[i], got = probe[i];
+                if (!(std::abs(got - want) <= 1e-5f * std::abs(want) + 1e-6f)) return false;
+            }
+            return true;
+        };
+
+        std::vector<uint32_t> best_spirv = spirv;
+        bool reference_timed = run_once(reference);
+        if (reference_timed) {
+            expected.assign(probe, probe + n);
+            const double ms = best_of(reference);
+            // Nothing to compare the variants against if the reference failed
+            reference_timed = std::isfinite(ms);
+            if (reference_timed) r.default_ms = r.best_ms = ms;
+        }
+        if (reference_timed) {
+            for (uint32_t size : local_size_candidates(device_)) {
+                if (size == r.default_local_size) continue;
+                if (size > r.default_local_size) break;  // Would dispatch past n
+                std::vector<uint32_t> variant = with_local_size(spirv, size);
+                if (variant.empty()) break;  // LocalSize not rewritable
+                const std::string kernel = name + "@" + std::to_string(size);
+                if (!scratch->load_kernel(kernel, variant.data(), variant.size())) continue;
+                if (!run_once(kernel) || !matches()) continue;
+                double ms = best_of(kernel);
+                if (!std::isfinite(ms)) continue;
+                r.candidates++;
+                if (ms < r.best_ms) {
+                    r.best_ms = ms;
+                    r.local_size = size;
+                    best_spirv = std::move(variant);
+                }
+            }
+        }
+        parallax_ufree(probe);
+        scratch.reset();
+        r.loaded = launcher.load_kernel(name, best_spirv.data(), best_spirv.size());
+        return r;
+    }
+
+    // One line per kernel: spirv_hash local_size default_local_size elements_per_invocation best_ms default_ms candidates
+    void load() {
+        std::ifstream in(path_);
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            TuneResult r;
+            if (fields >> key >> r.local_size >> r.default_local_size >> r.elements_per_invocation >> r.best_ms >>
+                r.default_ms >> r.candidates) {
+                choices_[key] = r;
+            }
+        }
+    }
+
+    void save() const {
+        std::error_code ec;
+        std::filesystem::create_directories(path_.parent_path(), ec);
+        std::ofstream out(path_, std::ios::trunc);
+        out.precision(17);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [key, r] : choices_) {
+            out << key << ' ' << r.local_size << ' ' << r.default_local_size << ' ' << r.elements_per_invocation
+                << ' ' << r.best_ms << ' ' << r.default_ms << ' ' << r.candidates << '\n';
+        }
+    }
+
+    DeviceInfo device_;
+    std::filesystem::path path_;
+    VulkanBackend* backend_;
+    MemoryManager* memory_;
+    mutable std::mutex mutex_;
+    std::map<std::string, TuneResult> choices_;
+};
+
+/// Process-wide tuner for @p device, reading its stored choices once.
+/// @p backend and @p memory must be that device's; they are used when the
+/// tuner is first created.
+inline AutoTuner& tuner_for(const DeviceInfo& device, VulkanBackend* backend = get_global_backend(),
+                            MemoryManager* memory = get_global_memory_manager()) {
+    static std::mutex mutex;
+    static std::map<std::string, std::unique_ptr<AutoTuner>> tuners;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& tuner = tuners[device.key()];
+    if (!tuner) tuner = std::make_unique<AutoTuner>(device, default_cache_dir(), backend, memory);
+    return *tuner;
+}
+
+/// tuner_for(primary_device()), with the device queried once.
+inline AutoTuner& primary_tuner() {
+    static AutoTuner& tuner = tuner_for(primary_device());
+    return tuner;
+}
+
+} // namespace parallax::samples
@@ -0,0 +1,478 @@
+/**
+ * @file bench_harness.hpp
+ * @brief Warmup, repetition statistics, roofline figures and baselines
+ *
+ * Averaging a handful of runs hides variance and lets a single cold run
+ * (kernel load, first-touch faults) dominate. BenchHarness runs a case
+ * through untimed warmups and then N timed repetitions, and reports:
+ *
+ *   median / p95 / p99 / stddev   over the timed repetitions
+ *   GB/s and GFLOP/s              from the per-run Work of the case
+ *   bytes per element             Work bytes over the case size
+ *   % of peak                     when the variant's peak is known
+ *
+ * Results can be written as JSON or CSV. A JSON file from an earlier run
+ * can be passed back with --compare, and finish() fails when any case's
+ * median has regressed beyond the tolerance, a baseline case did not run
+ * at all, or the baseline was recorded on a different device.
+ *
+ * Command-line flags (parsed by BenchOptions::parse, others are ignored):
+ *   --warmup N  --reps N  --json FILE  --csv FILE
+ *   --compare BASELINE.json  --tolerance FRACTION (default 0.10)
+ *
+ * Environment:
+ *   PARALLAX_PEAK_GBPS / PARALLAX_PEAK_GFLOPS            device peak ("gpu")
+ *   PARALLAX_HOST_PEAK_GBPS / PARALLAX_HOST_PEAK_GFLOPS  host peak ("cpu")
+ *   PARALLAX_METRICS=0  skip the metrics.hpp counters finish() prints
+ */
+
+#pragma once
+
+#include "common/metrics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace parallax::samples {
+
+struct BenchOptions {
+    int warmup = 2;
+    int repetitions = 0;       // 0: use the default each case passes to measure()
+    std::string json_path;
+    std::string csv_path;
+    std::string compare_path;
+    double tolerance = 0.10;   // Allowed median slowdown vs the baseline
+
+    static BenchOptions parse(int argc, char** argv) {
+        BenchOptions options;
+        for (int i = 1; i + 1 < argc; i++) {
+            const char* value = argv[i + 1];
+            if (std::strcmp(argv[i], "--warmup") == 0) options.warmup = std::max(0, std::atoi(value));
+            else if (std::strcmp(argv[i], "--reps") == 0) options.repetitions = std::max(1, std::atoi(value));
+            else if (std::strcmp(argv[i], "--json") == 0) options.json_path = value;
+            else if (std::strcmp(argv[i], "--csv") == 0) options.csv_path = value;
+            else if (std::strcmp(argv[i], "--compare") == 0) options.compare_path = value;
+            else if (std::strcmp(argv[i], "--tolerance") == 0) options.tolerance = std::atof(value);
+            else continue;
+            i++;
+        }
+        return options;
+    }
+};
+
+struct Summary {
+    int samples = 0;
+    double mean_ms = 0.0;
+    double median_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double stddev_ms = 0.0;
+    double min_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+/// Nearest-rank percentiles and sample standard deviation.
+inline Summary summarize(std::vector<double> samples) {
+    Summary s;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    const size_t n = samples.size();
+    auto rank = [&](double p) {
+        size_t r = static_cast<size_t>(std::ceil(p * n));
+        return samples[std::clamp<size_t>(r, 1, n) - 1];
+    };
+    s.samples = static_cast<int>(n);
+    s.mean_ms = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+    s.median_ms = n % 2 ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+    s.p95_ms = rank(0.95);
+    s.p99_ms = rank(0.99);
+    s.min_ms = samples.front();
+    s.max_ms = samples.back();
+    if (n > 1) {
+        double sq = 0.0;
+        for (double x : samples) sq += (x - s.mean_ms) * (x - s.mean_ms);
+        s.stddev_ms = std::sqrt(sq / (n - 1));
+    }
+    return s;
+}
+
+/// Work done by one run of a case (0 where it isn't meaningful).
+struct Work {
+    double bytes = 0.0;
+    double flops = 0.0;
+};
+
+/// Peak rates to report against; 0 means unknown.
+struct Peak {
+    double gbps = 0.0;
+    double gflops = 0.0;
+
+    static Peak from_env(const char* gbps_var, const char* gflops_var) {
+        Peak peak;
+        if (const char* v = std::getenv(gbps_var)) peak.gbps = std::atof(v);
+        if (const char* v = std::getenv(gflops_var)) peak.gflops = std::atof(v);
+        return peak;
+    }
+};
+
+struct BenchRecord {
+    std::string name;
+    std::string variant;
+    size_t size = 0;
+    Summary time;
+    Work work;
+    bool correct = true;
+
+    double gbps() const { return time.median_ms > 0.0 ? work.bytes / (time.median_ms * 1e6) : 0.0; }
+    double gflops() const { return time.median_ms > 0.0 ? work.flops / (time.median_ms * 1e6) : 0.0; }
+    double bytes_per_element() const { return size > 0 ? work.bytes / size : 0.0; }
+    std::string key() const { return name + "/" + variant + "/" + std::to_string(size); }
+};
+
+class BenchHarness {
+public:
+    BenchHarness(std::string suite, BenchOptions options, std::string device = "")
+        : suite_(std::move(suite)), device_(std::move(device)), options_(std::move(options)) {
+        peaks_["gpu"] = Peak::from_env("PARALLAX_PEAK_GBPS", "PARALLAX_PEAK_GFLOPS");
+        peaks_["cpu"] = Peak::from_env("PARALLAX_HOST_PEAK_GBPS", "PARALLAX_HOST_PEAK_GFLOPS");
+    }
+
+    const BenchOptions& options() const { return options_; }
+    void set_peak(const std::string& variant, Peak peak) { peaks_[variant] = peak; }
+
+    /// Run @p fn through the warmups and timed repetitions.
+    template<typename Fn>
+    Summary measure(Fn&& fn, int default_reps = 10) {
+        return measure([] {}, std::forward<Fn>(fn), default_reps);
+    }
+
+    /// As above, calling @p setup untimed before every run (e.g. to
+    /// restore the input of a destructive algorithm).
+    template<typename Setup, typename Fn>
+    Summary measure(Setup&& setup, Fn&& fn, int default_reps = 10) {
+        const int reps = options_.repetitions > 0 ? options_.repetitions : std::max(1, default_reps);
+        for (int i = 0; i < options_.warmup; i++) {
+            setup();
+            fn();
+        }
+        std::vector<double> samples;
+        samples.reserve(reps);
+        for (int i = 0; i < reps; i++) {
+            setup();
+            auto start = std::chrono::high_resolution_clock::now();
+            fn();
+            auto end = std::chrono::high_resolution_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return summarize(std::move(samples));
+    }
+
+    void print_header() const {
+        std::cout << suite_;
+        if (!device_.empty()) std::cout << " on " << device_;
+        std::cout << " (" << options_.warmup << " warmup";
+        if (options_.repetitions > 0) std::cout << ", " << options_.repetitions << " reps";
+        std::cout << ")" << std::endl;
+        for (const auto& [variant, peak] : peaks_) {
+            std::cout << "Peak " << variant << ": ";
+            if (peak.gbps > 0.0 || peak.gflops > 0.0) {
+                std::cout << peak.gbps << " GB/s, " << peak.gflops << " GFLOP/s" << std::endl;
+            } else {
+                std::cout << "unknown" << std::endl;
+            }
+        }
+        std::cout << std::endl;
+        std::cout << std::left << std::setw(14) << "Case"
+                  << std::setw(8) << "Size"
+                  << std::setw(5) << "On"
+                  << std::right
+                  << std::setw(11) << "Median ms"
+                  << std::setw(11) << "p95 ms"
+                  << std::setw(11) << "p99 ms"
+                  << std::setw(10) << "Stddev"
+                  << std::setw(9) << "GB/s"
+                  << std::setw(9) << "GFLOP/s"
+                  << std::setw(7) << "B/el"
+                  << std::setw(7) << "%Peak"
+                  << std::setw(9) << "Speedup"
+                  << "  Status" << std::endl;
+        std::cout << std::string(119, '-') << std::endl;
+    }
+
+    /// Store and print one result. Speedup is against the first variant
+    /// recorded for the same case and size.
+    const BenchRecord& record(const std::string& name, const std::string& variant, size_t size,
+                              const Summary& time, Work work, bool correct = true) {
+        records_.push_back({name, variant, size, time, work, correct});
+        const BenchRecord& r = records_.back();
+        const BenchRecord* reference = nullptr;
+        for (const auto& other : records_) {
+            if (other.name == name && other.size == size) { reference = &other; break; }
+        }
+
+        std::cout << std::left << std::setw(14) << name
+                  << std::setw(8) << format_count(size)
+                  << std::setw(5) << variant
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(11) << time.median_ms
+                  << std::setw(11) << time.p95_ms
+                  << std::setw(11) << time.p99_ms
+                  << std::setw(10) << time.stddev_ms
+                  << std::setprecision(2);
+        print_rate(work.bytes > 0.0, r.gbps());
+        print_rate(work.flops > 0.0, r.gflops());
+        if (work.bytes > 0.0) {
+            const double bpe = r.bytes_per_element();
+            if (bpe >= 100000.0) std::cout << std::setw(7) << (std::to_string(std::llround(bpe / 1024.0)) + "K");
+            else std::cout << std::setw(7) << std::setprecision(bpe < 100.0 ? 1 : 0) << bpe;
+        } else {
+            std::cout << std::setw(7) << "-";
+        }
+        double percent = percent_of_peak(r);
+        if (percent > 0.0) std::cout << std::setw(6) << std::setprecision(1) << percent << "%";
+        else std::cout << std::setw(7) << "-";
+        if (reference != &r && time.median_ms > 0.0) {
+            std::cout << std::setw(8) << std::setprecision(2) << reference->time.median_ms / time.median_ms << "x";
+        } else {
+            std::cout << std::setw(9) << "-";
+        }
+        std::cout << "  " << (correct ? "✓ PASS" : "✗ FAIL") << std::endl;
+        std::cout << std::left;
+        return r;
+    }
+
+    const std::vector<BenchRecord>& records() const { return records_; }
+
+    /// Write the requested outputs and check the baseline. Returns the
+    /// process exit code: 1 on any incorrect result or regression.
+    int finish() {
+        bool ok = std::all_of(records_.begin(), records_.end(), [](const BenchRecord& r) { return r.correct; });
+        if (!options_.json_path.empty()) write_json(options_.json_path);
+        if (!options_.csv_path.empty()) write_csv(options_.csv_path);
+        if (!options_.compare_path.empty()) ok = compare(options_.compare_path) && ok;
+        print_metrics();
+        return ok ? 0 : 1;
+    }
+
+    static std::string format_count(size_t n) {
+        if (n >= 1000000 && n % 1000000 == 0) return std::to_string(n / 1000000) + "M";
+        if (n >= 1000000 && n % 1024000 == 0) return std::to_string(n / 1024000) + "M";
+        if (n >= 1000 && n % 1000 == 0) return std::to_string(n / 1000) + "K";
+        if (n >= 1000 && n % 1024 == 0) return std::to_string(n / 1024) + "K";
+        return std::to_string(n);
+    }
+
+private:
+    static void print_rate(bool known, double value) {
+        if (known) std::cout << std::setw(9) << value;
+        else std::cout << std::setw(9) << "-";
+    }
+
+    // Against bandwidth for memory-bound cases, compute otherwise: whichever
+    // roof is closer is the one the case is limited by
+    double percent_of_peak(const BenchRecord& r) const {
+        auto it = peaks_.find(r.variant);
+        if (it == peaks_.end()) return 0.0;
+        double bw = it->second.gbps > 0.0 && r.work.bytes > 0.0 ? r.gbps() / it->second.gbps : 0.0;
+        double fp = it->second.gflops > 0.0 && r.work.flops > 0.0 ? r.gflops() / it->second.gflops : 0.0;
+        return 100.0 * std::max(bw, fp);
+    }
+
+    void write_json(const std::string& path) const {
+        std::ofstream out(path, std::ios::trunc);
+        out << std::setprecision(9);
+        out << "{\n  \"suite\": \"" << json_escape(suite_) << "\",\n  \"device\": \"" << json_escape(device_)
+            << "\",\n";
+        out << "  \"warmup\": " << options_.warmup << ",\n  \"results\": [\n";
+        for (size_t i = 0; i < records_.size(); i++) {
+            const BenchRecord& r = records_[i];
+            out << "    {\"case\": \"" << json_escape(r.name) << "\", \"variant\": \"" << json_escape(r.variant)
+                << "\", \"size\": " << r.size << ", \"samples\": " << r.time.samples
+                << ", \"median_ms\": " << r.time.median_ms << ", \"mean_ms\": " << r.time.mean_ms
+                << ", \"p95_ms\": " << r.time.p95_ms << ", \"p99_ms\": " << r.time.p99_ms
+                << ", \"stddev_ms\": " << r.time.stddev_ms << ", \"min_ms\": " << r.time.min_ms
+                << ", \"max_ms\": " << r.time.max_ms << ", \"gbps\": " << r.gbps()
+                << ", \"gflops\": " << r.gflops() << ", \"bytes_per_element\": " << r.bytes_per_element()
+                << ", \"correct\": " << (r.correct ? "true" : "false")
+                << "}" << (i + 1 < records_.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+        std::cout << "Wrote " << path << std::endl;
+    }
+
+    void write_csv(const std::string& path) const {
+        std::ofstream out(path, std::ios::trunc);
+        out << std::setprecision(9);
+        out << "case,variant,size,samples,median_ms,mean_ms,p95_ms,p99_ms,stddev_ms,min_ms,max_ms,gbps,gflops,bytes_per_element,correct\n";
+        for (const auto& r : records_) {
+            out << r.name << "," << r.variant << "," << r.size << "," << r.time.samples << ","
+                << r.time.median_ms << "," << r.time.mean_ms << "," << r.time.p95_ms << ","
+                << r.time.p99_ms << "," << r.time.stddev_ms << "," << r.time.min_ms << ","
+                << r.time.max_ms << "," << r.gbps() << "," << r.gflops() << ","
+                << r.bytes_per_element() << ","
+                << (r.correct ? 1 : 0) << "\n";
+        }
+        std::cout << "Wrote " << path << std::endl;
+    }
+
+    // Device names come from the driver and may hold quotes or backslashes
+    static std::string json_escape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                        out += buf;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+        return out;
+    }
+
+    // Index past the closing quote of the string opening at @p pos,
+    // unescaped into @p value when given
+    static size_t read_json_string(const std::string& text, size_t pos, std::string* value = nullptr) {
+        for (size_t i = pos + 1; i < text.size(); i++) {
+            char c = text[i];
+            if (c == '"') return i + 1;
+            if (c == '\\' && i + 1 < text.size()) {
+                c = text[++i];
+                if (c == 'n') c = '\n';
+                else if (c == 't') c = '\t';
+                else if (c == 'u' && i + 4 < text.size()) {
+                    c = static_cast<char>(std::strtol(text.substr(i + 1, 4).c_str(), nullptr, 16));
+                    i += 4;
+                }
+            }
+            if (value) *value += c;
+        }
+        return std::string::npos;
+    }
+
+    // Value of @p key in a flat JSON object, unescaped if it is a string
+    static std::string json_field(const std::string& object, const std::string& key) {
+        size_t pos = object.find("\"" + key + "\"");
+        if (pos == std::string::npos) return {};
+        pos = object.find(':', pos);
+        if (pos == std::string::npos) return {};
+        pos = object.find_first_not_of(" \t\n", pos + 1);
+        if (pos == std::string::npos) return {};
+        if (object[pos] == '"') {
+            std::string value;
+            read_json_string(object, pos, &value);
+            return value;
+        }
+        size_t end = object.find_first_of(",}", pos);
+        return object.substr(pos, end - pos);
+    }
+
+    struct Baseline {
+        std::string device;
+        std::map<std::string, double> medians;  // key -> median_ms
+    };
+
+    // Reads the flat result objects write_json() produces
+    static Baseline read_baseline(const std::string& path) {
+        Baseline baseline;
+        std::ifstream in(path);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        const std::string text = buffer.str();
+
+        size_t pos = text.find("\"results\"");
+        if (pos != std::string::npos) baseline.device = json_field(text.substr(0, pos), "device");
+        while (pos != std::string::npos) {
+            size_t begin = text.find('{', pos);
+            if (begin == std::string::npos) break;
+            // Braces inside strings do not close the object
+            size_t end = begin + 1;
+            while (end < text.size() && text[end] != '}') {
+                end = text[end] == '"' ? read_json_string(text, end) : end + 1;
+            }
+            if (end >= text.size()) break;
+            std::string object = text.substr(begin, end - begin + 1);
+            std::string median = json_field(object, "median_ms");
+            if (!median.empty()) {
+                baseline.medians[json_field(object, "case") + "/" + json_field(object, "variant") + "/" +
+                                 json_field(object, "size")] = std::atof(median.c_str());
+            }
+            pos = end + 1;
+        }
+        return baseline;
+    }
+
+    bool compare(const std::string& path) const {
+        const Baseline loaded = read_baseline(path);
+        const auto& baseline = loaded.medians;
+        if (baseline.empty()) {
+            std::cerr << "No results in baseline " << path << std::endl;
+            return false;
+        }
+        // Timings from another GPU say nothing about a regression on this one
+        if (!loaded.device.empty() && !device_.empty() && loaded.device != device_) {
+            std::cerr << "Baseline " << path << " was recorded on " << loaded.device << ", this run is on "
+                      << device_ << std::endl;
+            return false;
+        }
+        // Ignore differences below 10us: timer noise, not a regression
+        const double noise_ms = 0.01;
+        int regressions = 0, compared = 0;
+        std::cout << std::endl << "Compared against " << path << " (tolerance "
+                  << std::setprecision(0) << options_.tolerance * 100.0 << "%)" << std::endl;
+        for (const auto& r : records_) {
+            auto it = baseline.find(r.key());
+            if (it == baseline.end()) continue;
+            compared++;
+            double base = it->second;
+            if (r.time.median_ms > base * (1.0 + options_.tolerance) && r.time.median_ms - base > noise_ms) {
+                regressions++;
+                std::cout << "  REGRESSION " << r.key() << ": " << std::setprecision(3) << base
+                          << " -> " << r.time.median_ms << " ms (+"
+                          << std::setprecision(1) << (r.time.median_ms / base - 1.0) * 100.0 << "%)" << std::endl;
+            }
+        }
+        // A case that stopped running (allocation or kernel load failed,
+        // or it was dropped) must not pass as "no regression"
+        std::set<std::string> current;
+        for (const auto& r : records_) current.insert(r.key());
+        int missing = 0;
+        for (const auto& [key, base] : baseline) {
+            if (current.count(key)) continue;
+            missing++;
+            std::cout << "  MISSING " << key << ": in the baseline, not in this run" << std::endl;
+        }
+        std::cout << "  " << compared << " cases compared, " << regressions << " regressed, "
+                  << missing << " missing" << std::endl;
+        return regressions == 0 && missing == 0;
+    }
+
+    std::string suite_;
+    std::string device_;
+    BenchOptions options_;
+    std::map<std::string, Peak> peaks_;
+    std::vector<BenchRecord> records_;
+};
+
+} // namespace parallax::samples
@@ -0,0 +1,42 @@
+/**
+ * @file cache_dir.hpp
+ * @brief Location of the persistent per-user Parallax cache and key hashing
+ *
+ * Shared by the kernel cache and the other helpers that persist
+ * calibration results between runs.
+ *
+ * Environment:
+ *   PARALLAX_CACHE_DIR  override the cache directory
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+namespace parallax::samples {
+
+/// 64-bit FNV-1a, stable across platforms and runs.
+inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+inline uint64_t fnv1a(const std::string& s) { return fnv1a(s.data(), s.size()); }
+
+/// Resolve the cache directory from the environment.
+inline std::filesystem::path default_cache_dir() {
+    if (const char* dir = std::getenv("PARALLAX_CACHE_DIR")) return dir;
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) return std::filesystem::path(xdg) / "parallax";
+    if (const char* home = std::getenv("HOME")) return std::filesystem::path(home) / ".cache" / "parallax";
+    return std::filesystem::temp_directory_path() / "parallax";
+}
+
+} // namespace parallax::samples
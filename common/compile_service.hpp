@@ -0,0 +1,236 @@
+/**
+ * @file compile_service.hpp
+ * @brief Background kernel compilation from a startup manifest
+ *
+ * The first call into a code path that compiles its lambda synchronously
+ * stalls for the whole compile. Two pieces avoid that:
+ *
+ *   PARALLAX_PRECOMPILE(name, lambda)  registers the lambda in the
+ *       process-wide CompileManifest during static initialization, the
+ *       in-source equivalent of a manifest written at build time.
+ *   CompileService  compiles every manifest entry on a small thread pool
+ *       (one LambdaCompiler per worker) through a KernelCache.
+ *
+ * Call sites look up their KernelHandle by name and use run_when_ready():
+ * the CPU fallback runs until the kernel is ready, then the GPU path runs.
+ */
+
+#pragma once
+
+#include <parallax/lambda_compiler.hpp>
+#include "common/kernel_cache.hpp"
+#include "common/metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parallax::samples {
+
+/// Completion handle for one background compile (cheap to copy).
+class KernelHandle {
+public:
+    KernelHandle() = default;
+
+    bool valid() const { return static_cast<bool>(state_); }
+    bool ready() const { return state_ && state_->ready.load(std::memory_order_acquire); }
+
+    /// Block until compiled; empty on failure.
+    const std::vector<uint32_t>& wait() const {
+        static const std::vector<uint32_t> none;
+        if (!state_) return none;
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->cv.wait(lock, [&] { return state_->ready.load(std::memory_order_relaxed); });
+        return state_->spirv;
+    }
+
+    /// Valid once ready().
+    const std::vector<uint32_t>& spirv() const { return state_->spirv; }
+    bool ok() const { return ready() && !state_->spirv.empty(); }
+    double compile_ms() const { return state_ ? state_->compile_ms : 0.0; }
+    const std::string& name() const { return state_->name; }
+
+private:
+    friend class CompileService;
+
+    struct State {
+        std::string name;
+        std::atomic<bool> ready{false};
+        std::vector<uint32_t> spirv;
+        double compile_ms = 0.0;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+
+    explicit KernelHandle(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<State> state_;
+};
+
+using CompileJob = std::function<std::vector<uint32_t>(LambdaCompiler&, KernelCache&)>;
+
+/// Kernels to compile at startup, in registration order.
+class CompileManifest {
+public:
+    static CompileManifest& instance() {
+        static CompileManifest manifest;
+        return manifest;
+    }
+
+    template<typename Lambda>
+    bool add(std::string name, Lambda lambda) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.emplace_back(std::move(name), [lambda](LambdaCompiler& compiler, KernelCache& cache) {
+            return cache.compile(compiler, lambda);
+        });
+        return true;
+    }
+
+    std::vector<std::pair<std::string, CompileJob>> entries() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::string, CompileJob>> entries_;
+};
+
+#define PARALLAX_PRECOMPILE(name, ...)                                                   \
+    static const bool parallax_precompile_##name [[maybe_unused]] =                       \
+        ::parallax::samples::CompileManifest::instance().add(#name, __VA_ARGS__)
+
+class CompileService {
+public:
+    /// @param threads workers; 0 picks half the hardware threads (at least 1)
+    explicit CompileService(KernelCache& cache, unsigned threads = 0) : cache_(cache) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+        for (unsigned i = 0; i < threads; i++) workers_.emplace_back([this] { run(); });
+    }
+
+    ~CompileService() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    CompileService(const CompileService&) = delete;
+    CompileService& operator=(const CompileService&) = delete;
+
+    /// Queue one compile; a name that is already queued returns its handle.
+    KernelHandle submit(const std::string& name, CompileJob job) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = handles_.find(name);
+        if (it != handles_.end()) return it->second;
+        auto state = std::make_shared<KernelHandle::State>();
+        state->name = name;
+        KernelHandle handle(state);
+        handles_.emplace(name, handle);
+        queue_.push_back({state, std::move(job)});
+        cv_.notify_one();
+        return handle;
+    }
+
+    template<typename Lambda>
+    KernelHandle submit(const std::string& name, Lambda lambda) {
+        return submit(name, CompileJob([lambda](LambdaCompiler& compiler, KernelCache& cache) {
+            return cache.compile(compiler, lambda);
+        }));
+    }
+
+    /// Queue every manifest entry.
+    void submit(const CompileManifest& manifest) {
+        for (auto& [name, job] : manifest.entries()) submit(name, job);
+    }
+
+    /// Handle for @p name, invalid if it was never submitted.
+    KernelHandle handle(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = handles_.find(name);
+        return it == handles_.end() ? KernelHandle() : it->second;
+    }
+
+    /// Block until every submitted kernel has finished compiling.
+    void wait_all() const {
+        std::vector<KernelHandle> all;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [name, handle] : handles_) all.push_back(handle);
+        }
+        for (const auto& h : all) h.wait();
+    }
+
+    size_t thread_count() const { return workers_.size(); }
+
+private:
+    struct Task {
+        std::shared_ptr<KernelHandle::State> state;
+        CompileJob job;
+    };
+
+    void run() {
+        LambdaCompiler compiler;  // Per worker: no sharing across threads
+        for (;;) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+                if (stopping_ && queue_.empty()) return;
+                task = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            std::vector<uint32_t> spirv;
+            auto start = std::chrono::high_resolution_clock::now();
+            try {
+                spirv = task.job(compiler, cache_);
+            } catch (...) {
+                spirv.clear();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            {
+                std::lock_guard<std::mutex> lock(task.state->mutex);
+                task.state->spirv = std::move(spirv);
+                task.state->compile_ms = std::chrono::duration<double, std::milli>(end - start).count();
+                task.state->ready.store(true, std::memory_order_release);
+            }
+            task.state->cv.notify_all();
+        }
+    }
+
+    KernelCache& cache_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> queue_;
+    std::map<std::string, KernelHandle> handles_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+/// Run @p gpu(spirv) if @p kernel has compiled successfully, else @p cpu().
+/// Returns true when the GPU path ran.
+template<typename Cpu, typename Gpu>
+bool run_when_ready(const KernelHandle& kernel, Cpu&& cpu, Gpu&& gpu) {
+    if (kernel.ok()) {
+        gpu(kernel.spirv());
+        return true;
+    }
+    if (kernel.valid()) metrics().add_fallback(kernel.name(), kernel.ready() ? "compile failed" : "still compiling");
+    cpu();
+    return false;
+}
+
+} // namespace parallax::samples
@@ -0,0 +1,235 @@
+/**
+ * @file device_info.hpp
+ * @brief Read-only Vulkan physical-device enumeration for the samples
+ *
+ * The runtime does not expose which physical device VulkanBackend picked,
+ * so helpers that need a device identity (persisted calibration, memory
+ * sizing, subgroup width) query Vulkan directly through a short-lived
+ * instance. primary_device() mirrors the usual selection rule: the first
+ * discrete GPU, else the first device.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace parallax::samples {
+
+struct DeviceInfo {
+    uint32_t index = 0;
+    std::string name = "unknown";
+    uint32_t vendor_id = 0;
+    uint32_t device_id = 0;
+    uint32_t driver_version = 0;
+    uint32_t api_version = 0;
+    bool discrete = false;
+    uint32_t subgroup_size = 0;          // 0 if Vulkan 1.1 is unavailable
+    uint32_t max_workgroup_invocations = 0;
+    uint64_t device_local_bytes = 0;     // Largest DEVICE_LOCAL heap
+    bool has_pci = false;                // VK_EXT_pci_bus_info available
+    uint32_t pci_domain = 0, pci_bus = 0, pci_device = 0, pci_function = 0;
+
+    /// Stable identity for keys: changes with the GPU model or driver.
+    std::string key() const {
+        return name + "-" + std::to_string(vendor_id) + ":" + std::to_string(device_id) +
+               "-drv" + std::to_string(driver_version);
+    }
+
+    /// "dddd:bb:dd.f", as in /sys/bus/pci/devices; empty without has_pci.
+    std::string pci_address() const {
+        if (!has_pci) return "";
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%04x:%02x:%02x.%x", pci_domain, pci_bus, pci_device, pci_function);
+        return buf;
+    }
+
+    const char* vendor() const {
+        switch (vendor_id) {
+            case 0x10DE: return "NVIDIA";
+            case 0x1002: return "AMD";
+            case 0x8086: return "Intel";
+            case 0x13B5: return "ARM";
+            case 0x5143: return "Qualcomm";
+            case 0x106B: return "Apple";
+            default: return "unknown";
+        }
+    }
+};
+
+namespace detail {
+
+/// RAII Vulkan instance used only for enumeration.
+class ProbeInstance {
+public:
+    ProbeInstance() {
+        VkApplicationInfo app{};
+        app.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        app.pApplicationName = "parallax-samples-probe";
+        app.apiVersion = VK_API_VERSION_1_1;
+
+        VkInstanceCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        info.pApplicationInfo = &app;
+#ifdef __APPLE__
+        // MoltenVK is a portability driver
+        static const char* extensions[] = {"VK_KHR_portability_enumeration"};
+        info.flags = 0x00000001;  // VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR
+        info.enabledExtensionCount = 1;
+        info.ppEnabledExtensionNames = extensions;
+#endif
+        if (vkCreateInstance(&info, nullptr, &instance_) != VK_SUCCESS) instance_ = nullptr;
+    }
+
+    ~ProbeInstance() {
+        if (instance_) vkDestroyInstance(instance_, nullptr);
+    }
+
+    ProbeInstance(const ProbeInstance&) = delete;
+    ProbeInstance& operator=(const ProbeInstance&) = delete;
+
+    std::vector<VkPhysicalDevice> devices() const {
+        std::vector<VkPhysicalDevice> list;
+        if (!instance_) return list;
+        uint32_t count = 0;
+        vkEnumeratePhysicalDevices(instance_, &count, nullptr);
+        list.resize(count);
+        if (count) vkEnumeratePhysicalDevices(instance_, &count, list.data());
+        list.resize(count);
+        return list;
+    }
+
+private:
+    VkInstance instance_ = nullptr;
+};
+
+inline bool has_extension(VkPhysicalDevice device, const char* name) {
+    uint32_t count = 0;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &count, nullptr);
+    std::vector<VkExtensionProperties> extensions(count);
+    if (count) vkEnumerateDeviceExtensionProperties(device, nullptr, &count, extensions.data());
+    for (uint32_t i = 0; i < count; i++) {
+        if (std::strcmp(extensions[i].extensionName, name) == 0) return true;
+    }
+    return false;
+}
+
+inline DeviceInfo describe(VkPhysicalDevice device, uint32_t index) {
+    DeviceInfo info;
+    info.index = index;
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(device, &props);
+    info.name = props.deviceName;
+    info.vendor_id = props.vendorID;
+    info.device_id = props.deviceID;
+    info.driver_version = props.driverVersion;
+    info.api_version = props.apiVersion;
+    info.discrete = (props.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
+    info.max_workgroup_invocations = props.limits.maxComputeWorkGroupInvocations;
+
+    if (props.apiVersion >= VK_API_VERSION_1_1) {
+        VkPhysicalDeviceSubgroupProperties subgroup{};
+        subgroup.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+        VkPhysicalDeviceProperties2 props2{};
+        props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        props2.pNext = &subgroup;
+        vkGetPhysicalDeviceProperties2(device, &props2);
+        info.subgroup_size = subgroup.subgroupSize;
+    }
+
+#ifdef VK_EXT_pci_bus_info
+    // PCIe address, for NUMA placement next to the device
+    if (props.apiVersion >= VK_API_VERSION_1_1) {
+        if (has_extension(device, VK_EXT_PCI_BUS_INFO_EXTENSION_NAME)) {
+            VkPhysicalDevicePCIBusInfoPropertiesEXT pci{};
+            pci.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PCI_BUS_INFO_PROPERTIES_EXT;
+            VkPhysicalDeviceProperties2 props2{};
+            props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            props2.pNext = &pci;
+            vkGetPhysicalDeviceProperties2(device, &props2);
+            info.has_pci = true;
+            info.pci_domain = pci.pciDomain;
+            info.pci_bus = pci.pciBus;
+            info.pci_device = pci.pciDevice;
+            info.pci_function = pci.pciFunction;
+        }
+    }
+#endif
+
+    VkPhysicalDeviceMemoryProperties memory{};
+    vkGetPhysicalDeviceMemoryProperties(device, &memory);
+    for (uint32_t i = 0; i < memory.memoryHeapCount; i++) {
+        if ((memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) &&
+            memory.memoryHeaps[i].size > info.device_local_bytes) {
+            info.device_local_bytes = memory.memoryHeaps[i].size;
+        }
+    }
+    return info;
+}
+
+} // namespace detail
+
+/// Every physical device visible to the Vulkan loader.
+inline std::vector<DeviceInfo> enumerate_devices() {
+    detail::ProbeInstance probe;
+    std::vector<DeviceInfo> infos;
+    uint32_t index = 0;
+    for (VkPhysicalDevice device : probe.devices()) {
+        infos.push_back(detail::describe(device, index++));
+    }
+    return infos;
+}
+
+/// The device the runtime is expected to run on.
+inline DeviceInfo primary_device() {
+    auto devices = enumerate_devices();
+    for (const auto& d : devices) {
+        if (d.discrete) return d;
+    }
+    return devices.empty() ? DeviceInfo{} : devices.front();
+}
+
+struct MemoryBudget {
+    bool known = false;          // VK_EXT_memory_budget available
+    uint64_t budget_bytes = 0;   // What this process can use without eviction
+    uint64_t usage_bytes = 0;    // What this process currently uses
+};
+
+/// Budget and usage summed over @p device's DEVICE_LOCAL heaps. Usage is
+/// per process, so it includes the runtime's allocations; while a working
+/// set larger than the budget is live, usage staying at the budget means
+/// the driver or runtime is paging.
+inline MemoryBudget memory_budget(const DeviceInfo& device) {
+    MemoryBudget result;
+#ifdef VK_EXT_memory_budget
+    detail::ProbeInstance probe;
+    auto devices = probe.devices();
+    if (device.index >= devices.size() || device.api_version < VK_API_VERSION_1_1) return result;
+    VkPhysicalDevice physical = devices[device.index];
+    if (!detail::has_extension(physical, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) return result;
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
+    budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    VkPhysicalDeviceMemoryProperties2 memory{};
+    memory.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    memory.pNext = &budget;
+    vkGetPhysicalDeviceMemoryProperties2(physical, &memory);
+    for (uint32_t i = 0; i < memory.memoryProperties.memoryHeapCount; i++) {
+        if (!(memory.memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)) continue;
+        result.budget_bytes += budget.heapBudget[i];
+        result.usage_bytes += budget.heapUsage[i];
+    }
+    result.known = true;
+#else
+    (void)device;
+#endif
+    return result;
+}
+
+} // namespace parallax::samples
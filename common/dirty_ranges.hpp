@@ -0,0 +1,124 @@
+/**
+ * @file dirty_ranges.hpp
+ * @brief Explicit, coalesced dirty-range tracking for unified buffers
+ *
+ * Page-fault based dirty detection charges a fault per touched page and
+ * gives the runtime no way to batch. Hot loops that know what they wrote
+ * can record it here instead: mark() rounds each write out to the tracking
+ * block size and merges it with neighbours, and flush() hands the merged
+ * ranges to parallax_umark_dirty in one pass before the next launch.
+ *
+ * parallax_umark_dirty / parallax_uprefetch are probed at configure time
+ * (PARALLAX_HAS_UMARK_DIRTY / PARALLAX_HAS_UPREFETCH). Without them flush()
+ * still reports the ranges, and the runtime falls back to fault tracking.
+ *
+ * Environment:
+ *   PARALLAX_DIRTY_BLOCK_KB  tracking block size, default 64
+ */
+
+#pragma once
+
+#include <parallax/runtime.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace parallax::samples {
+
+/// Whether the runtime exposes explicit dirty marking.
+constexpr bool has_explicit_dirty() {
+#ifdef PARALLAX_HAS_UMARK_DIRTY
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// Hint that [ptr, ptr + bytes) will be used on @p device soon; no-op if
+/// the runtime lacks parallax_uprefetch.
+inline void prefetch(void* ptr, size_t bytes, int device = 0) {
+#ifdef PARALLAX_HAS_UPREFETCH
+    parallax_uprefetch(ptr, bytes, device);
+#else
+    (void)ptr; (void)bytes; (void)device;
+#endif
+}
+
+class DirtyRangeSet {
+public:
+    static size_t default_block_size() {
+        const char* env = std::getenv("PARALLAX_DIRTY_BLOCK_KB");
+        size_t kb = env ? std::strtoull(env, nullptr, 10) : 64;
+        return std::max<size_t>(kb, 4) << 10;
+    }
+
+    /// @param base  start of the unified allocation being tracked
+    /// @param bytes its size
+    DirtyRangeSet(void* base, size_t bytes, size_t block_size = default_block_size())
+        : base_(static_cast<char*>(base)), bytes_(bytes), block_(block_size) {}
+
+    /// Record a host write of @p n bytes at @p p.
+    void mark(const void* p, size_t n) {
+        if (n == 0) return;
+        size_t begin = static_cast<size_t>(static_cast<const char*>(p) - base_);
+        size_t end = std::min(bytes_, begin + n);
+        begin = begin / block_ * block_;
+        end = std::min(bytes_, (end + block_ - 1) / block_ * block_);
+
+        // Merge with every range that overlaps or touches [begin, end)
+        auto it = ranges_.upper_bound(begin);
+        if (it != ranges_.begin()) {
+            auto prev = std::prev(it);
+            if (prev->second >= begin) it = prev;
+        }
+        while (it != ranges_.end() && it->first <= end) {
+            begin = std::min(begin, it->first);
+            end = std::max(end, it->second);
+            it = ranges_.erase(it);
+        }
+        ranges_.emplace(begin, end);
+    }
+
+    /// Mark every range with the runtime and clear; returns bytes marked.
+    size_t flush() {
+        size_t total = 0;
+        for (const auto& [begin, end] : ranges_) {
+#ifdef PARALLAX_HAS_UMARK_DIRTY
+            parallax_umark_dirty(base_ + begin, end - begin);
+#endif
+            total += end - begin;
+        }
+        ranges_.clear();
+        return total;
+    }
+
+    size_t dirty_bytes() const {
+        size_t total = 0;
+        for (const auto& [begin, end] : ranges_) total += end - begin;
+        return total;
+    }
+
+    size_t range_count() const { return ranges_.size(); }
+    size_t block_size() const { return block_; }
+
+    /// Merged [offset, offset + length) pairs, relative to the base.
+    std::vector<std::pair<size_t, size_t>> ranges() const {
+        std::vector<std::pair<size_t, size_t>> out;
+        for (const auto& [begin, end] : ranges_) out.emplace_back(begin, end - begin);
+        return out;
+    }
+
+private:
+    char* base_;
+    size_t bytes_;
+    size_t block_;
+    std::map<size_t, size_t> ranges_;  // begin -> end, disjoint and non-adjacent
+};
+
+} // namespace parallax::samples
@@ -0,0 +1,242 @@
+/**
+ * @file dispatch_policy.hpp
+ * @brief Per-call CPU/GPU selection from a calibrated per-kernel cost model
+ *
+ * Each kernel gets two linear models fitted over the bytes it touches:
+ *
+ *   t_cpu(bytes) = cpu_fixed + cpu_per_byte * bytes
+ *   t_gpu(bytes) = gpu_fixed + gpu_per_byte * bytes
+ *
+ * gpu_fixed captures launch and coherence overhead, which is why the GPU
+ * loses at small sizes. calibrate() times both backends over a size sweep
+ * once per device and fails, storing nothing, if any timed run fails; the
+ * fitted models are persisted under the cache directory so later runs
+ * choose immediately. choose() returns the
+ * backend together with a human-readable reason for auditing.
+ */
+
+#pragma once
+
+#include "common/cache_dir.hpp"
+#include "common/metrics.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace parallax::samples {
+
+enum class Backend { CPU, GPU };
+
+inline const char* to_string(Backend b) { return b == Backend::CPU ? "CPU" : "GPU"; }
+
+struct DispatchDecision {
+    Backend backend = Backend::CPU;
+    double predicted_cpu_ms = 0.0;
+    double predicted_gpu_ms = 0.0;
+    std::string reason;
+};
+
+struct CostModel {
+    double cpu_fixed_ms = 0.0;
+    double cpu_per_byte_ms = 0.0;
+    double gpu_fixed_ms = 0.0;
+    double gpu_per_byte_ms = 0.0;
+
+    double cpu_ms(double bytes) const { return cpu_fixed_ms + cpu_per_byte_ms * bytes; }
+    double gpu_ms(double bytes) const { return gpu_fixed_ms + gpu_per_byte_ms * bytes; }
+
+    /// Bytes from which the GPU wins at every larger size: 0 if it always
+    /// does, nullopt if it does not win at large sizes at all.
+    std::optional<double> crossover_bytes() const {
+        if (gpu_per_byte_ms > cpu_per_byte_ms) return std::nullopt;
+        if (gpu_per_byte_ms == cpu_per_byte_ms) {
+            return gpu_fixed_ms < cpu_fixed_ms ? std::optional<double>(0.0) : std::nullopt;
+        }
+        return std::max(0.0, (gpu_fixed_ms - cpu_fixed_ms) / (cpu_per_byte_ms - gpu_per_byte_ms));
+    }
+};
+
+/// crossover_bytes() divided by @p unit_bytes, for printing ("never" if
+/// the GPU doesn't win at large sizes).
+inline std::string format_crossover(const CostModel& model, size_t unit_bytes = 1) {
+    auto bytes = model.crossover_bytes();
+    if (!bytes) return "never";
+    return std::to_string(static_cast<uint64_t>(*bytes / unit_bytes));
+}
+
+class DispatchPolicy {
+public:
+    /// Time one run of a backend over @p elements elements, in ms; nullopt
+    /// if the run failed.
+    using Runner = std::function<std::optional<double>(size_t elements)>;
+
+    struct KernelStats {
+        uint64_t cpu_calls = 0;
+        uint64_t gpu_calls = 0;
+    };
+
+    /// Without calibration data, fall back to the README rule of thumb.
+    static constexpr size_t kDefaultThresholdElements = 10240;
+
+    /// @param device_key identity of the device the models belong to
+    explicit DispatchPolicy(std::string device_key,
+                            std::filesystem::path dir = default_cache_dir())
+        : path_(dir / ("dispatch-" + std::to_string(fnv1a(device_key)) + ".txt")) {
+        load();
+    }
+
+    bool calibrated(const std::string& kernel) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return models_.count(kernel) != 0;
+    }
+
+    /// Fit both models for @p kernel by timing @p cpu and @p gpu over
+    /// @p sizes (median of @p reps runs each) and persist the result.
+    /// nullopt, with any earlier model kept, if a run failed: a model
+    /// fitted to failed launches would send calls to a broken backend.
+    std::optional<CostModel> calibrate(const std::string& kernel, size_t bytes_per_element,
+                                       const Runner& cpu, const Runner& gpu,
+                                       const std::vector<size_t>& sizes, int reps = 3) {
+        std::vector<double> xs, cpu_ys, gpu_ys;
+        for (size_t n : sizes) {
+            auto cpu_ms = median_of(cpu, n, reps);
+            auto gpu_ms = median_of(gpu, n, reps);
+            if (!cpu_ms || !gpu_ms) return std::nullopt;
+            xs.push_back(static_cast<double>(n * bytes_per_element));
+            cpu_ys.push_back(*cpu_ms);
+            gpu_ys.push_back(*gpu_ms);
+        }
+        CostModel model;
+        fit(xs, cpu_ys, model.cpu_fixed_ms, model.cpu_per_byte_ms);
+        fit(xs, gpu_ys, model.gpu_fixed_ms, model.gpu_per_byte_ms);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            models_[kernel] = model;
+        }
+        save();
+        return model;
+    }
+
+    /// Pick a backend for one call touching @p bytes over @p elements.
+    DispatchDecision choose(const std::string& kernel, size_t elements, size_t bytes) {
+        DispatchDecision d;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = models_.find(kernel);
+        if (it == models_.end()) {
+            d.backend = elements >= kDefaultThresholdElements ? Backend::GPU : Backend::CPU;
+            d.reason = "uncalibrated: " + std::to_string(elements) +
+                       (d.backend == Backend::GPU ? " >= " : " < ") +
+                       std::to_string(kDefaultThresholdElements) + " elements";
+        } else {
+            const CostModel& m = it->second;
+            d.predicted_cpu_ms = m.cpu_ms(static_cast<double>(bytes));
+            d.predicted_gpu_ms = m.gpu_ms(static_cast<double>(bytes));
+            d.backend = d.predicted_gpu_ms < d.predicted_cpu_ms ? Backend::GPU : Backend::CPU;
+            std::ostringstream reason;
+            reason << "model: cpu " << d.predicted_cpu_ms << " ms vs gpu " << d.predicted_gpu_ms
+                   << " ms at " << bytes << " B (crossover " << format_crossover(m) << " B)";
+            d.reason = reason.str();
+        }
+        auto& s = stats_[kernel];
+        (d.backend == Backend::GPU ? s.gpu_calls : s.cpu_calls)++;
+        metrics().add_decision(kernel, d.backend == Backend::GPU);
+        return d;
+    }
+
+    /// Choose, run the chosen backend and return the decision.
+    DispatchDecision run(const std::string& kernel, size_t elements, size_t bytes,
+                         const std::function<void()>& cpu, const std::function<void()>& gpu) {
+        DispatchDecision d = choose(kernel, elements, bytes);
+        if (d.backend == Backend::GPU) gpu();
+        else cpu();
+        return d;
+    }
+
+    CostModel model(const std::string& kernel) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = models_.find(kernel);
+        return it == models_.end() ? CostModel{} : it->second;
+    }
+
+    std::map<std::string, KernelStats> stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    static std::optional<double> median_of(const Runner& run, size_t n, int reps) {
+        if (!run(n)) return std::nullopt;  // Warm caches, page mappings and pipelines
+        std::vector<double> times;
+        for (int i = 0; i < reps; i++) {
+            auto ms = run(n);
+            if (!ms) return std::nullopt;
+            times.push_back(*ms);
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    // Relative least-squares line (weights 1/y^2), so the microsecond
+    // points that set the fixed cost are not drowned out by the large
+    // sizes. Clamped so tiny sizes never predict negative time.
+    static void fit(const std::vector<double>& xs, const std::vector<double>& ys,
+                    double& intercept, double& slope) {
+        double sw = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (size_t i = 0; i < xs.size(); i++) {
+            const double y = std::max(ys[i], 1e-6);
+            const double w = 1.0 / (y * y);
+            sw += w;
+            sx += w * xs[i];
+            sy += w * ys[i];
+            sxx += w * xs[i] * xs[i];
+            sxy += w * xs[i] * ys[i];
+        }
+        const double denom = sw * sxx - sx * sx;
+        slope = denom != 0.0 ? (sw * sxy - sx * sy) / denom : 0.0;
+        intercept = sw != 0.0 ? std::max(0.0, (sy - slope * sx) / sw) : 0.0;
+        slope = std::max(0.0, slope);
+    }
+
+    // One line per kernel: name cpu_fixed cpu_per_byte gpu_fixed gpu_per_byte
+    void load() {
+        std::ifstream in(path_);
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string name;
+            CostModel m;
+            if (fields >> name >> m.cpu_fixed_ms >> m.cpu_per_byte_ms >> m.gpu_fixed_ms >> m.gpu_per_byte_ms) {
+                models_[name] = m;
+            }
+        }
+    }
+
+    void save() const {
+        std::error_code ec;
+        std::filesystem::create_directories(path_.parent_path(), ec);
+        std::ofstream out(path_, std::ios::trunc);
+        out.precision(17);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, m] : models_) {
+            out << name << ' ' << m.cpu_fixed_ms << ' ' << m.cpu_per_byte_ms << ' '
+                << m.gpu_fixed_ms << ' ' << m.gpu_per_byte_ms << '\n';
+        }
+    }
+
+    std::filesystem::path path_;
+    mutable std::mutex mutex_;
+    std::map<std::string, CostModel> models_;
+    std::map<std::string, KernelStats> stats_;
+};
+
+} // namespace parallax::samples
@@ -0,0 +1,142 @@
+/**
+ * @file fusion.hpp
+ * @brief Deferred element-wise chains that run as one fused kernel
+ *
+ * Every std::transform / std::for_each under std::execution::par becomes
+ * its own dispatch and its own full pass over memory. lazy() collects
+ * adjacent element-wise stages over the same range instead and issues a
+ * single std::for_each whose lambda applies all of them, so the compiler
+ * generates one kernel that reads and writes each element once.
+ *
+ *   auto chain = parallax::samples::lazy(data, data + n)
+ *                    .transform([](float x) { return x * 2.0f; })
+ *                    .for_each([](float& x) { x += 1.0f; });
+ *   float sum = std::move(chain).reduce(0.0f);   // flush + reduce
+ *
+ * Stages are stored by value in the chain's type, so the fused lambda is
+ * an ordinary closure the compiler plugin can see through. Pending stages
+ * run at the first host access: flush(), data(), a terminal reduce, or
+ * destruction of the chain.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+namespace parallax::samples {
+
+namespace detail {
+
+/// transform stage: x = f(x)
+template<typename F>
+struct map_stage {
+    F f;
+    template<typename T> void operator()(T& x) const { x = f(x); }
+};
+
+/// for_each stage: f(x), modifying in place
+template<typename F>
+struct inplace_stage {
+    F f;
+    template<typename T> void operator()(T& x) const { f(x); }
+};
+
+} // namespace detail
+
+template<typename T, typename... Stages>
+class lazy_range {
+public:
+    lazy_range(T* first, T* last, std::tuple<Stages...> stages = {})
+        : first_(first), last_(last), stages_(std::move(stages)) {}
+
+    lazy_range(lazy_range&& other) noexcept
+        : first_(other.first_), last_(other.last_), stages_(std::move(other.stages_)),
+          pending_(other.pending_) {
+        other.pending_ = false;
+    }
+
+    lazy_range(const lazy_range&) = delete;
+    lazy_range& operator=(const lazy_range&) = delete;
+    lazy_range& operator=(lazy_range&&) = delete;
+
+    ~lazy_range() { flush(); }
+
+    /// Defer x = f(x) (std::transform with out == in).
+    template<typename F>
+    lazy_range<T, Stages..., detail::map_stage<F>> transform(F f) && {
+        return append(detail::map_stage<F>{std::move(f)});
+    }
+
+    /// Defer f(x) on each element (std::for_each).
+    template<typename F>
+    lazy_range<T, Stages..., detail::inplace_stage<F>> for_each(F f) && {
+        return append(detail::inplace_stage<F>{std::move(f)});
+    }
+
+    /// Run all pending stages as one std::for_each dispatch.
+    void flush() {
+        if (!pending_) return;
+        pending_ = false;
+        if constexpr (sizeof...(Stages) > 0) {
+            auto stages = stages_;
+            std::for_each(std::execution::par, first_, last_, [stages](T& x) {
+                std::apply([&x](const auto&... stage) { (stage(x), ...); }, stages);
+            });
+        }
+    }
+
+    /// Host access point: flushes, then exposes the range.
+    T* data() {
+        flush();
+        return first_;
+    }
+
+    /// Flush, then reduce the materialized range (two passes instead of
+    /// one per stage plus one).
+    template<typename Init, typename Op = std::plus<>>
+    Init reduce(Init init, Op op = {}) && {
+        flush();
+        return std::reduce(std::execution::par, first_, last_, init, op);
+    }
+
+    /// Fold the pending stages into a single std::transform_reduce without
+    /// writing them back: one read-only pass. The range is left unchanged.
+    template<typename Init, typename Op = std::plus<>>
+    Init map_reduce(Init init, Op op = {}) && {
+        pending_ = false;
+        auto stages = stages_;
+        return std::transform_reduce(std::execution::par, first_, last_, init, op,
+                                     [stages](T x) {
+                                         std::apply([&x](const auto&... stage) { (stage(x), ...); }, stages);
+                                         return x;
+                                     });
+    }
+
+    static constexpr size_t stage_count() { return sizeof...(Stages); }
+
+private:
+    template<typename Stage>
+    lazy_range<T, Stages..., Stage> append(Stage stage) {
+        pending_ = false;  // Ownership of the stages moves to the new chain
+        return lazy_range<T, Stages..., Stage>(
+            first_, last_, std::tuple_cat(std::move(stages_), std::make_tuple(std::move(stage))));
+    }
+
+    T* first_;
+    T* last_;
+    std::tuple<Stages...> stages_;
+    bool pending_ = true;
+};
+
+/// Start a deferred chain over [first, last).
+template<typename T>
+lazy_range<T> lazy(T* first, T* last) {
+    return lazy_range<T>(first, last);
+}
+
+} // namespace parallax::samples
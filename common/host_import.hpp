@@ -0,0 +1,115 @@
+/**
+ * @file host_import.hpp
+ * @brief Make an existing host range (mmap'd file, network buffer) GPU-accessible
+ *
+ * Samples normally copy their inputs into parallax_umalloc memory first.
+ * HostRange registers memory the application already owns instead:
+ *
+ *   zero copy  parallax_uimport(ptr, bytes) maps the pages into the device
+ *              (VK_EXT_external_memory_host); data() is ptr itself.
+ *   staged     the runtime lacks parallax_uimport, or refused the range
+ *              (device without the extension, misaligned pointer): the
+ *              range is copied into a parallax_umalloc buffer, and writable
+ *              ranges are copied back by commit().
+ *
+ * parallax_uimport is probed at configure time (PARALLAX_HAS_UIMPORT). An
+ * imported range is released with parallax_ufree, which drops the
+ * registration and leaves the host memory to its owner.
+ *
+ * The staged fallback needs a second copy of the whole range; stream it
+ * with stream_transform() instead when it may not fit.
+ */
+
+#pragma once
+
+#include <parallax/runtime.h>
+#include "common/metrics.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+namespace parallax::samples {
+
+/// Whether the runtime exposes host-memory import.
+constexpr bool has_host_import() {
+#ifdef PARALLAX_HAS_UIMPORT
+    return true;
+#else
+    return false;
+#endif
+}
+
+class HostRange {
+public:
+    enum class Mode { ZeroCopy, Staged, Failed };
+
+    /// @param writable copy the staged buffer back to @p ptr on commit()
+    HostRange(void* ptr, size_t bytes, bool writable = false)
+        : host_(ptr), bytes_(bytes), writable_(writable) {
+        auto start = std::chrono::high_resolution_clock::now();
+#ifdef PARALLAX_HAS_UIMPORT
+        if (parallax_uimport(ptr, bytes) == 0) {
+            mode_ = Mode::ZeroCopy;
+            data_ = ptr;
+        }
+#endif
+        if (mode_ != Mode::ZeroCopy) {
+            data_ = parallax_umalloc(bytes, 0);
+            if (data_) {
+                std::memcpy(data_, ptr, bytes);
+                metrics().add_staged_in(bytes);
+                mode_ = Mode::Staged;
+            }
+        }
+        setup_ms_ = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    ~HostRange() {
+        if (mode_ != Mode::Failed) parallax_ufree(data_);
+    }
+
+    HostRange(const HostRange&) = delete;
+    HostRange& operator=(const HostRange&) = delete;
+
+    /// Pointer to pass to kernels; nullptr if staging allocation failed.
+    void* data() const { return data_; }
+    template<typename T>
+    T* as() const { return static_cast<T*>(data_); }
+
+    size_t bytes() const { return bytes_; }
+    Mode mode() const { return mode_; }
+    bool ok() const { return mode_ != Mode::Failed; }
+    bool zero_copy() const { return mode_ == Mode::ZeroCopy; }
+
+    /// Time spent importing (zero copy) or allocating and copying in (staged).
+    double setup_ms() const { return setup_ms_; }
+
+    /// Make GPU writes visible at the original pointer. A no-op unless the
+    /// range is staged and writable.
+    void commit() {
+        if (mode_ == Mode::Staged && writable_) {
+            std::memcpy(host_, data_, bytes_);
+            metrics().add_staged_out(bytes_);
+        }
+    }
+
+private:
+    void* host_;
+    size_t bytes_;
+    bool writable_;
+    Mode mode_ = Mode::Failed;
+    void* data_ = nullptr;
+    double setup_ms_ = 0.0;
+};
+
+inline const char* mode_name(HostRange::Mode mode) {
+    switch (mode) {
+        case HostRange::Mode::ZeroCopy: return "zero-copy";
+        case HostRange::Mode::Staged: return "staged";
+        default: return "failed";
+    }
+}
+
+} // namespace parallax::samples
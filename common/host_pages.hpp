@@ -0,0 +1,176 @@
+/**
+ * @file host_pages.hpp
+ * @brief Huge-page and NUMA-placed host buffers for large CPU-side arrays
+ *
+ * A 100M-float array on 4 KB pages is 100K TLB entries' worth of pages,
+ * placed on whichever socket first touched each page. HostPages maps the
+ * buffer itself so both can be chosen before the first touch:
+ *
+ *   PageMode::Default      4 KB pages (transparent huge pages disabled for
+ *                          the range, so this is a real baseline)
+ *   PageMode::Transparent  2 MB-aligned mapping with madvise(MADV_HUGEPAGE)
+ *   PageMode::Explicit     MAP_HUGETLB 2 MB pages from the reserved pool
+ *                          (vm.nr_hugepages); falls back to Transparent
+ *                          when the pool is empty
+ *
+ * and, with a NUMA node, an mbind(MPOL_BIND) so every page lands on that
+ * node. device_numa_node() reads the node of the GPU's PCIe root from
+ * sysfs. The parallax_umalloc host copy belongs to the runtime, so to get
+ * these pages under a kernel import the buffer with HostRange.
+ *
+ * Linux only; elsewhere the buffer is an ordinary page-aligned allocation
+ * and mode() reports Default.
+ */
+
+#pragma once
+
+#include "common/device_info.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace parallax::samples {
+
+enum class PageMode { Default, Transparent, Explicit };
+
+inline const char* page_mode_name(PageMode mode) {
+    switch (mode) {
+        case PageMode::Default: return "4K pages";
+        case PageMode::Transparent: return "transparent 2M";
+        case PageMode::Explicit: return "explicit 2M";
+    }
+    return "unknown";
+}
+
+constexpr size_t kHugePageBytes = size_t(2) << 20;
+
+/// Number of NUMA nodes the kernel reports online; 1 if unknown.
+inline int numa_node_count() {
+#ifdef __linux__
+    std::ifstream f("/sys/devices/system/node/online");  // e.g. "0" or "0-1"
+    std::string list;
+    if (!(f >> list)) return 1;
+    size_t pos = list.find_last_of("-,");
+    return std::atoi(list.c_str() + (pos == std::string::npos ? 0 : pos + 1)) + 1;
+#else
+    return 1;
+#endif
+}
+
+/// The system-wide transparent huge page setting ("always", "madvise",
+/// "never"), or "" where there is none.
+inline std::string thp_setting() {
+#ifdef __linux__
+    std::ifstream f("/sys/kernel/mm/transparent_hugepage/enabled");  // "always [madvise] never"
+    std::string line;
+    std::getline(f, line);
+    size_t open = line.find('['), close = line.find(']');
+    if (open != std::string::npos && close > open) return line.substr(open + 1, close - open - 1);
+#endif
+    return "";
+}
+
+/// NUMA node of @p device's PCIe root; -1 if unknown.
+inline int device_numa_node(const DeviceInfo& device) {
+#ifdef __linux__
+    if (!device.has_pci) return -1;
+    std::ifstream f("/sys/bus/pci/devices/" + device.pci_address() + "/numa_node");
+    int node = -1;
+    if (f >> node) return node;
+#else
+    (void)device;
+#endif
+    return -1;
+}
+
+class HostPages {
+public:
+    /// @param numa_node bind the pages to this node; -1 leaves first-touch placement
+    HostPages(size_t bytes, PageMode mode, int numa_node = -1) : bytes_(bytes), requested_(mode) {
+        mapped_ = (bytes + kHugePageBytes - 1) / kHugePageBytes * kHugePageBytes;
+#ifdef __linux__
+#ifdef MAP_HUGE_SHIFT
+        if (mode == PageMode::Explicit) {
+            void* p = mmap(nullptr, mapped_, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1, 0);
+            if (p != MAP_FAILED) {
+                data_ = p;
+                mode_ = PageMode::Explicit;
+            }
+        }
+#endif
+        if (!data_) map_aligned(mode == PageMode::Default ? PageMode::Default : PageMode::Transparent);
+        if (data_ && numa_node >= 0 && numa_node < 64) {
+            unsigned long mask = 1UL << numa_node;
+            if (syscall(SYS_mbind, data_, mapped_, MPOL_BIND, &mask, sizeof(mask) * 8, 0) == 0) {
+                numa_node_ = numa_node;
+            }
+        }
+#else
+        (void)numa_node;
+        data_ = std::aligned_alloc(4096, mapped_);
+#endif
+    }
+
+    ~HostPages() {
+        if (!data_) return;
+#ifdef __linux__
+        munmap(data_, mapped_);
+#else
+        std::free(data_);
+#endif
+    }
+
+    HostPages(const HostPages&) = delete;
+    HostPages& operator=(const HostPages&) = delete;
+
+    /// Untouched memory: the first write places each page.
+    void* data() const { return data_; }
+    template<typename T>
+    T* as() const { return static_cast<T*>(data_); }
+
+    size_t bytes() const { return bytes_; }
+    bool ok() const { return data_ != nullptr; }
+    PageMode requested() const { return requested_; }
+    /// What was actually mapped (Explicit falls back to Transparent).
+    PageMode mode() const { return mode_; }
+    /// Bound node, or -1 if not bound.
+    int numa_node() const { return numa_node_; }
+
+private:
+#ifdef __linux__
+    // Over-map by one huge page and trim both ends to a 2 MB boundary
+    void map_aligned(PageMode mode) {
+        const size_t span = mapped_ + kHugePageBytes;
+        void* p = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) return;
+        char* raw = static_cast<char*>(p);
+        char* base = reinterpret_cast<char*>(
+            (reinterpret_cast<uintptr_t>(raw) + kHugePageBytes - 1) & ~(uintptr_t)(kHugePageBytes - 1));
+        if (base > raw) munmap(raw, base - raw);
+        if (raw + span > base + mapped_) munmap(base + mapped_, raw + span - (base + mapped_));
+        madvise(base, mapped_, mode == PageMode::Transparent ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+        data_ = base;
+        mode_ = mode;
+    }
+#endif
+
+    void* data_ = nullptr;
+    size_t bytes_ = 0;
+    size_t mapped_ = 0;
+    PageMode requested_;
+    PageMode mode_ = PageMode::Default;
+    int numa_node_ = -1;
+};
+
+} // namespace parallax::samples
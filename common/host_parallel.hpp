@@ -0,0 +1,94 @@
+/**
+ * @file host_parallel.hpp
+ * @brief Plain std::thread parallel loop for CPU baselines
+ *
+ * In samples built with the offload plugin, std::execution::par calls may
+ * themselves be sent to the GPU, so they can't serve as the CPU side of a
+ * comparison. host_parallel_for() splits [0, n) into one contiguous block
+ * per hardware thread and never leaves the host; host_parallel_reduce()
+ * folds per-block partials the same way.
+ *
+ * Environment:
+ *   PARALLAX_HOST_THREADS  worker count, default hardware_concurrency()
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace parallax::samples {
+
+inline unsigned host_threads() {
+    if (const char* env = std::getenv("PARALLAX_HOST_THREADS")) {
+        int n = std::atoi(env);
+        if (n > 0) return static_cast<unsigned>(n);
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Number of blocks the helpers below split [0, n) into.
+inline size_t host_block_count(size_t n) {
+    return std::min<size_t>(host_threads(), std::max<size_t>(n, 1));
+}
+
+/// Call @p fn(block, begin, end) on host_block_count(n) disjoint blocks
+/// covering [0, n), one per thread. Trailing blocks may be empty.
+template<typename Fn>
+void host_parallel_indexed_blocks(size_t n, Fn&& fn) {
+    const size_t threads = host_block_count(n);
+    if (threads <= 1) {
+        fn(size_t(0), size_t(0), n);
+        return;
+    }
+    const size_t block = (n + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; t++) {
+        size_t begin = std::min(n, t * block), end = std::min(n, begin + block);
+        workers.emplace_back([&fn, t, begin, end] { fn(t, begin, end); });
+    }
+    fn(size_t(0), size_t(0), std::min(n, block));  // Block 0 on the calling thread
+    for (auto& w : workers) w.join();
+}
+
+/// Call @p fn(begin, end) on disjoint blocks covering [0, n), one per thread.
+template<typename Fn>
+void host_parallel_blocks(size_t n, Fn&& fn) {
+    host_parallel_indexed_blocks(n, [&fn](size_t, size_t begin, size_t end) { fn(begin, end); });
+}
+
+/// Call @p fn(i) for every i in [0, n).
+template<typename Fn>
+void host_parallel_for(size_t n, Fn&& fn) {
+    host_parallel_blocks(n, [&fn](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) fn(i);
+    });
+}
+
+/// Fold @p init and every fn(i), i in [0, n), with @p op. Each thread folds
+/// its own block and the partials are combined in block order, so @p op
+/// must be associative and commutative, as for std::reduce.
+template<typename T, typename Op, typename Fn>
+T host_parallel_reduce(size_t n, T init, Op op, Fn&& fn) {
+    const size_t blocks = host_block_count(n);
+    std::vector<T> partials(blocks, init);
+    std::vector<char> filled(blocks, 0);
+    host_parallel_indexed_blocks(n, [&](size_t b, size_t begin, size_t end) {
+        if (begin == end) return;
+        T acc = static_cast<T>(fn(begin));
+        for (size_t i = begin + 1; i < end; i++) acc = op(acc, static_cast<T>(fn(i)));
+        partials[b] = acc;
+        filled[b] = 1;
+    });
+    T result = init;
+    for (size_t b = 0; b < blocks; b++) {
+        if (filled[b]) result = op(result, partials[b]);
+    }
+    return result;
+}
+
+} // namespace parallax::samples
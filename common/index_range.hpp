@@ -0,0 +1,121 @@
+/**
+ * @file index_range.hpp
+ * @brief Counting iterators: for_each over [0, n) without an index buffer
+ *
+ *   std::for_each(std::execution::par, index_begin(0), index_begin(n),
+ *                 [=](size_t i) { out[i] = in[i - 1] + in[i + 1]; });
+ *
+ * or, equivalently, over index_range(n). Dereferencing yields the index
+ * itself, so no iota array is allocated or uploaded; the lambda reaches
+ * its data through captured pointers. Unlike std::views::iota the
+ * iterators are tagged random-access, which the parallel algorithms need
+ * to split the range.
+ *
+ * index_domain_2d / index_domain_3d cover a box of a grid. Iterate the
+ * flat range and have unflatten() hand the lambda its coordinates:
+ *
+ *   index_domain_2d interior(nx - 2, ny - 2, 1, 1);
+ *   std::for_each(std::execution::par, interior.begin(), interior.end(),
+ *                 interior.unflatten([=](size_t x, size_t y) { ... }));
+ *
+ * x varies fastest, matching row-major storage, so neighbouring
+ * invocations touch neighbouring cells.
+ */
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+
+namespace parallax::samples {
+
+class counting_iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = size_t;
+    using pointer = void;
+    
+    counting_iterator() = default;
+    explicit counting_iterator(size_t i) : i_(i) {}
+    
+    size_t operator*() const { return i_; }
+    size_t operator[](difference_type d) const { return i_ + d; }
+    
+    counting_iterator& operator++() { ++i_; return *this; }
+    counting_iterator operator++(int) { counting_iterator t = *this; ++i_; return t; }
+    counting_iterator& operator--() { --i_; return *this; }
+    counting_iterator operator--(int) { counting_iterator t = *this; --i_; return t; }
+    counting_iterator& operator+=(difference_type d) { i_ += d; return *this; }
+    counting_iterator& operator-=(difference_type d) { i_ -= d; return *this; }
+    friend counting_iterator operator+(counting_iterator it, difference_type d) { return it += d; }
+    friend counting_iterator operator+(difference_type d, counting_iterator it) { return it += d; }
+    friend counting_iterator operator-(counting_iterator it, difference_type d) { return it -= d; }
+    friend difference_type operator-(counting_iterator a, counting_iterator b) {
+        return static_cast<difference_type>(a.i_) - static_cast<difference_type>(b.i_);
+    }
+    friend bool operator==(counting_iterator a, counting_iterator b) { return a.i_ == b.i_; }
+    friend auto operator<=>(counting_iterator a, counting_iterator b) { return a.i_ <=> b.i_; }
+
+private:
+    size_t i_ = 0;
+};
+
+inline counting_iterator index_begin(size_t i) { return counting_iterator(i); }
+
+/// [first, last) as a begin()/end() pair.
+struct index_range {
+    size_t first = 0;
+    size_t last = 0;
+    
+    explicit index_range(size_t n) : last(n) {}
+    index_range(size_t first, size_t last) : first(first), last(last) {}
+    
+    counting_iterator begin() const { return counting_iterator(first); }
+    counting_iterator end() const { return counting_iterator(last); }
+    size_t size() const { return last - first; }
+};
+
+/// [x0, x0 + nx) x [y0, y0 + ny), flattened with x fastest.
+struct index_domain_2d {
+    size_t nx = 0, ny = 0;
+    size_t x0 = 0, y0 = 0;
+    
+    index_domain_2d(size_t nx, size_t ny, size_t x0 = 0, size_t y0 = 0) : nx(nx), ny(ny), x0(x0), y0(y0) {}
+    
+    counting_iterator begin() const { return counting_iterator(0); }
+    counting_iterator end() const { return counting_iterator(size()); }
+    size_t size() const { return nx * ny; }
+    
+    /// Adapt @p fn(x, y) to the flat index the algorithms pass.
+    template<typename Fn>
+    auto unflatten(Fn fn) const {
+        const size_t w = nx, ox = x0, oy = y0;
+        return [=](size_t i) { fn(ox + i % w, oy + i / w); };
+    }
+};
+
+/// [x0, x0 + nx) x [y0, y0 + ny) x [z0, z0 + nz), flattened with x fastest.
+struct index_domain_3d {
+    size_t nx = 0, ny = 0, nz = 0;
+    size_t x0 = 0, y0 = 0, z0 = 0;
+    
+    index_domain_3d(size_t nx, size_t ny, size_t nz, size_t x0 = 0, size_t y0 = 0, size_t z0 = 0)
+        : nx(nx), ny(ny), nz(nz), x0(x0), y0(y0), z0(z0) {}
+    
+    counting_iterator begin() const { return counting_iterator(0); }
+    counting_iterator end() const { return counting_iterator(size()); }
+    size_t size() const { return nx * ny * nz; }
+    
+    /// Adapt @p fn(x, y, z) to the flat index the algorithms pass.
+    template<typename Fn>
+    auto unflatten(Fn fn) const {
+        const size_t w = nx, h = ny, ox = x0, oy = y0, oz = z0;
+        return [=](size_t i) { fn(ox + i % w, oy + (i / w) % h, oz + i / (w * h)); };
+    }
+};
+
+} // namespace parallax::samples
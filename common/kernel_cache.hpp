@@ -0,0 +1,396 @@
+/**
+ * @file kernel_cache.hpp
+ * @brief Content-addressed SPIR-V cache in front of LambdaCompiler::compile
+ *
+ * Two layers: an in-process map and an on-disk directory
+ * (default ~/.cache/parallax). Entries are keyed on the kernel identity
+ * (lambda body + build id of the calling binary), the target device and
+ * the compiler version, so a rebuilt binary or an upgraded toolchain
+ * never picks up stale SPIR-V. Closure type names are only unique within
+ * one program (clang names them $_0, $_1, ...), so the default build id
+ * is the main source file plus the path, size and modification time of
+ * the running executable: samples built in the same second and sharing
+ * the directory never see each other's entries. The default device is
+ * primary_device().key(), which changes with the GPU model and driver.
+ *
+ * Entries that can never be hit again are pruned when a cache opens its
+ * directory: those written by the same binary (the build id up to '@')
+ * under an older build or compiler version, and those for the same GPU
+ * under an older driver.
+ *
+ * The body is the closure type, so [m](float& x) { x *= m; } maps to one
+ * entry whatever m holds, as long as the generator passes captures as
+ * launch parameters (push constants). On the first miss for a body with
+ * captures, a copy with every capture byte perturbed is compiled as well.
+ * If its SPIR-V differs, the values are baked into the module, and that
+ * body is keyed on its capture bytes too, so values never share SPIR-V.
+ * The verdict is remembered per body, in memory and on disk, so later
+ * values of a baking body compile once rather than twice.
+ * Values that must be compile-time constants can opt in explicitly by
+ * making them template parameters of the lambda, which gives each value
+ * its own closure type.
+ *
+ * Environment:
+ *   PARALLAX_CACHE_DIR      override the cache directory
+ *   PARALLAX_KERNEL_CACHE=0 disable the on-disk layer
+ */
+
+#pragma once
+
+#include <parallax/lambda_compiler.hpp>
+#include "common/cache_dir.hpp"
+#include "common/device_info.hpp"
+#include "common/metrics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef PARALLAX_SAMPLES_COMPILER_VERSION
+#define PARALLAX_SAMPLES_COMPILER_VERSION "unknown"
+#endif
+
+// The translation unit being compiled, not this header
+#ifdef __BASE_FILE__
+#define PARALLAX_SAMPLES_SOURCE __BASE_FILE__
+#else
+#define PARALLAX_SAMPLES_SOURCE __FILE__
+#endif
+
+namespace parallax::samples {
+
+/// Build id for cache keys: "<source> <executable>@<stamp> <size> <mtime>".
+/// The part before '@' names the binary, the rest changes on every rebuild.
+inline std::string binary_id(const std::string& source, const std::string& stamp) {
+    std::string exe = "?";
+    std::string build = stamp;
+    std::error_code ec;
+#ifdef __linux__
+    auto path = std::filesystem::read_symlink("/proc/self/exe", ec);
+    if (!ec) {
+        exe = path.string();
+        auto size = std::filesystem::file_size(path, ec);
+        if (!ec) build += " " + std::to_string(size);
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        if (!ec) build += " " + std::to_string(mtime.time_since_epoch().count());
+    }
+#endif
+    return source + " " + exe + "@" + build;
+}
+
+class KernelCache {
+public:
+    enum class Source { Memory, Disk, Compiled };
+
+    struct Stats {
+        uint64_t memory_hits = 0;
+        uint64_t disk_hits = 0;
+        uint64_t misses = 0;
+    };
+
+    /// @param device   target device identifier; defaults to default_device()
+    /// @param build_id identity of the calling binary; defaults to
+    ///                 binary_id() of the including translation unit
+    explicit KernelCache(std::string device = default_device(),
+                         std::string build_id = binary_id(PARALLAX_SAMPLES_SOURCE, __DATE__ " " __TIME__),
+                         std::filesystem::path dir = default_cache_dir())
+        : device_(std::move(device)), build_id_(std::move(build_id)), dir_(std::move(dir)) {
+        const char* env = std::getenv("PARALLAX_KERNEL_CACHE");
+        disk_enabled_ = !(env && std::string(env) == "0");
+        if (disk_enabled_) prune();
+    }
+
+    /// Key of the device the runtime is expected to run on, queried once.
+    static const std::string& default_device() {
+        static const std::string key = primary_device().key();
+        return key;
+    }
+
+    /// Return SPIR-V for @p lambda, compiling only on a miss in both layers.
+    template<typename Lambda>
+    std::vector<uint32_t> compile(LambdaCompiler& compiler, Lambda&& lambda, Source* source = nullptr) {
+        const std::string body = make_key(body_id<Lambda>());
+        const std::string valued = make_key(value_id(compiler, lambda));
+
+        std::vector<uint32_t> spirv;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const std::string* key : {&body, &valued}) {
+                auto it = memory_.find(*key);
+                if (it != memory_.end()) {
+                    memory_hits_.fetch_add(1, std::memory_order_relaxed);
+                    metrics().add_cache_memory_hit();
+                    if (source) *source = Source::Memory;
+                    return it->second;
+                }
+            }
+        }
+
+        std::string key = body;
+        if (load(body, spirv) || (valued != body && load(key = valued, spirv))) {
+            disk_hits_.fetch_add(1, std::memory_order_relaxed);
+            metrics().add_cache_disk_hit();
+            if (source) *source = Source::Disk;
+        } else {
+            spirv = compiler.compile(lambda);
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            metrics().add_cache_miss();
+            if (source) *source = Source::Compiled;
+            key = valued != body && bakes_captures(compiler, lambda, body, spirv) ? valued : body;
+            store(key, spirv);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        memory_.emplace(key, spirv);
+        return spirv;
+    }
+
+    /// Identity of a lambda body: its closure type, independent of the
+    /// values it captured.
+    template<typename Lambda>
+    static std::string body_id() {
+        return std::string("body:") + typeid(std::remove_cvref_t<Lambda>).name();
+    }
+
+    /// Drop the in-memory layer (simulates a fresh process).
+    void clear_memory() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        memory_.clear();
+        baked_.clear();
+    }
+
+    /// Remove every on-disk entry written by this cache format.
+    void clear_disk() {
+        std::error_code ec;
+        if (!std::filesystem::exists(dir_, ec)) return;
+        for (const auto& entry : std::filesystem::directory_iterator(dir_, ec)) {
+            if (entry.path().extension() == ".pxk") std::filesystem::remove(entry.path(), ec);
+        }
+    }
+
+    /// Remove on-disk entries that no longer match this cache: same binary
+    /// but another build, another compiler version, or the same GPU under
+    /// another driver. Returns the number removed.
+    size_t prune() {
+        std::error_code ec;
+        if (!std::filesystem::exists(dir_, ec)) return 0;
+        const std::string origin = build_id_.substr(0, build_id_.find('@'));
+        const std::string gpu = device_.substr(0, device_.rfind("-drv"));
+        size_t removed = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(dir_, ec)) {
+            if (entry.path().extension() != ".pxk") continue;
+            std::string kernel, build, device, version;
+            if (!read_key(entry.path(), kernel, build, device, version)) continue;
+            const bool same_binary = build.find('@') != std::string::npos &&
+                                     build.substr(0, build.find('@')) == origin;
+            const bool same_gpu = device.substr(0, device.rfind("-drv")) == gpu;
+            const bool stale = (same_binary && build != build_id_) ||
+                               (same_binary && version != PARALLAX_SAMPLES_COMPILER_VERSION) ||
+                               (same_gpu && device != device_);
+            std::error_code rm;
+            if (stale && std::filesystem::remove(entry.path(), rm)) removed++;
+        }
+        return removed;
+    }
+
+    Stats stats() const {
+        return {memory_hits_.load(std::memory_order_relaxed),
+                disk_hits_.load(std::memory_order_relaxed),
+                misses_.load(std::memory_order_relaxed)};
+    }
+
+    const std::filesystem::path& directory() const { return dir_; }
+    bool disk_enabled() const { return disk_enabled_; }
+
+    static const char* to_string(Source s) {
+        switch (s) {
+            case Source::Memory: return "memory hit";
+            case Source::Disk: return "disk hit";
+            case Source::Compiled: return "miss";
+        }
+        return "?";
+    }
+
+private:
+    static constexpr uint32_t kMagic = 0x4b58504e;  // "NPXK"
+    static constexpr uint32_t kFormatVersion = 1;
+    static constexpr uint32_t kMaxKeyBytes = 1u << 16;
+    static constexpr uint32_t kMaxWords = 1u << 24;
+
+    // Body plus capture bytes; the compiler's kernel name stands in when
+    // the captures can't be hashed bytewise
+    template<typename Lambda>
+    static std::string value_id(LambdaCompiler& compiler, const Lambda& lambda) {
+        using Closure = std::remove_cvref_t<Lambda>;
+        if constexpr (std::is_empty_v<Closure>) {
+            return body_id<Lambda>();
+        } else if constexpr (std::is_trivially_copyable_v<Closure>) {
+            char hash[24];
+            std::snprintf(hash, sizeof(hash), "#%016llx",
+                          static_cast<unsigned long long>(fnv1a(&lambda, sizeof(Closure))));
+            return body_id<Lambda>() + hash;
+        } else {
+            return "name:" + compiler.get_kernel_name(lambda);
+        }
+    }
+
+    // Compile a copy with the low bit of every capture byte flipped (still
+    // a valid bool, float or pointer) and see whether the module changes
+    template<typename Lambda>
+    static bool captures_baked(LambdaCompiler& compiler, const Lambda& lambda,
+                               const std::vector<uint32_t>& spirv) {
+        using Closure = std::remove_cvref_t<Lambda>;
+        if constexpr (std::is_empty_v<Closure>) {
+            return false;
+        } else if constexpr (std::is_trivially_copyable_v<Closure>) {
+            alignas(Closure) unsigned char bytes[sizeof(Closure)];
+            std::memcpy(bytes, &lambda, sizeof(Closure));
+            for (auto& b : bytes) b ^= 1;
+            try {
+                return compiler.compile(*std::launder(reinterpret_cast<Closure*>(bytes))) != spirv;
+            } catch (...) {
+                return true;
+            }
+        } else {
+            return true;
+        }
+    }
+
+    // captures_baked(), answered once per body: the verdict is kept in
+    // memory and as a one-word entry on disk
+    template<typename Lambda>
+    bool bakes_captures(LambdaCompiler& compiler, const Lambda& lambda, const std::string& body,
+                        const std::vector<uint32_t>& spirv) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = baked_.find(body);
+            if (it != baked_.end()) return it->second;
+        }
+        const std::string verdict_key = "baked:" + body;
+        std::vector<uint32_t> verdict;
+        bool baked;
+        if (load(verdict_key, verdict) && verdict.size() == 1) {
+            baked = verdict[0] != 0;
+        } else {
+            baked = captures_baked(compiler, lambda, spirv);
+            store(verdict_key, {baked ? 1u : 0u});
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        baked_[body] = baked;
+        return baked;
+    }
+
+    std::string make_key(const std::string& kernel_name) const {
+        return kernel_name + '\n' + build_id_ + '\n' + device_ + '\n' +
+               PARALLAX_SAMPLES_COMPILER_VERSION;
+    }
+
+    std::filesystem::path path_for(const std::string& key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.pxk",
+                      static_cast<unsigned long long>(fnv1a(key)));
+        return dir_ / name;
+    }
+
+    // Layout: magic, version, key length, word count, payload checksum,
+    // key bytes, SPIR-V words. The stored key guards against hash collisions.
+    bool load(const std::string& key, std::vector<uint32_t>& spirv) const {
+        if (!disk_enabled_) return false;
+        std::ifstream in(path_for(key), std::ios::binary);
+        if (!in) return false;
+
+        uint32_t header[4];
+        uint64_t checksum = 0;
+        in.read(reinterpret_cast<char*>(header), sizeof(header));
+        in.read(reinterpret_cast<char*>(&checksum), sizeof(checksum));
+        if (!in || header[0] != kMagic || header[1] != kFormatVersion) return false;
+        if (header[2] > kMaxKeyBytes || header[3] > kMaxWords) return false;
+
+        std::string stored_key(header[2], '\0');
+        in.read(stored_key.data(), stored_key.size());
+        if (!in || stored_key != key) return false;
+
+        spirv.resize(header[3]);
+        in.read(reinterpret_cast<char*>(spirv.data()), spirv.size() * sizeof(uint32_t));
+        if (!in || fnv1a(spirv.data(), spirv.size() * sizeof(uint32_t)) != checksum) {
+            spirv.clear();
+            return false;
+        }
+        return true;
+    }
+
+    // The four make_key() fields of the entry at @p path
+    static bool read_key(const std::filesystem::path& path, std::string& kernel, std::string& build,
+                         std::string& device, std::string& version) {
+        std::ifstream in(path, std::ios::binary);
+        uint32_t header[4];
+        uint64_t checksum = 0;
+        in.read(reinterpret_cast<char*>(header), sizeof(header));
+        in.read(reinterpret_cast<char*>(&checksum), sizeof(checksum));
+        if (!in || header[0] != kMagic || header[1] != kFormatVersion || header[2] > kMaxKeyBytes) return false;
+        std::string key(header[2], '\0');
+        in.read(key.data(), key.size());
+        if (!in) return false;
+        std::istringstream fields(key);
+        return std::getline(fields, kernel) && std::getline(fields, build) && std::getline(fields, device) &&
+               std::getline(fields, version);
+    }
+
+    void store(const std::string& key, const std::vector<uint32_t>& spirv) const {
+        if (!disk_enabled_ || spirv.empty()) return;
+        std::error_code ec;
+        std::filesystem::create_directories(dir_, ec);
+        if (ec) return;
+
+        // Write to a temporary and rename so concurrent processes never
+        // observe a partially written entry.
+        const auto final_path = path_for(key);
+        auto tmp_path = final_path;
+        tmp_path += ".tmp" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!out) return;
+            const uint32_t header[4] = {kMagic, kFormatVersion,
+                                        static_cast<uint32_t>(key.size()),
+                                        static_cast<uint32_t>(spirv.size())};
+            const uint64_t checksum = fnv1a(spirv.data(), spirv.size() * sizeof(uint32_t));
+            out.write(reinterpret_cast<const char*>(header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+            out.write(key.data(), key.size());
+            out.write(reinterpret_cast<const char*>(spirv.data()), spirv.size() * sizeof(uint32_t));
+            if (!out) {
+                std::filesystem::remove(tmp_path, ec);
+                return;
+            }
+        }
+        std::filesystem::rename(tmp_path, final_path, ec);
+        if (ec) std::filesystem::remove(tmp_path, ec);
+    }
+
+    std::string device_;
+    std::string build_id_;
+    std::filesystem::path dir_;
+    bool disk_enabled_ = true;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<uint32_t>> memory_;
+    std::unordered_map<std::string, bool> baked_;  // Body key -> captures baked into SPIR-V
+    std::atomic<uint64_t> memory_hits_{0};
+    std::atomic<uint64_t> disk_hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace parallax::samples
@@ -0,0 +1,76 @@
+/**
+ * @file kernel_preload.hpp
+ * @brief Build kernel pipelines once at startup instead of on first launch
+ *
+ * KernelLauncher::load_kernel creates the shader module and compute
+ * pipeline. Calling it inside a timed region (or once per benchmark size)
+ * charges pipeline creation to every dispatch measurement. preload() loads
+ * a set of kernels into one long-lived launcher and reports what each
+ * pipeline cost, so callers can print it separately.
+ *
+ * Kernels are loaded through AutoTuner::load_tuned(): one with a stored
+ * choice for the device gets its tuned workgroup size, and one without is
+ * tuned first, so that preload's create_ms includes the sweep. With
+ * PARALLAX_AUTOTUNE=0 only stored choices are applied.
+ */
+
+#pragma once
+
+#include <parallax/kernel_launcher.hpp>
+#include "common/autotune.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace parallax::samples {
+
+struct KernelSpec {
+    std::string name;
+    const uint32_t* spirv;
+    size_t spirv_size;
+};
+
+struct PreloadResult {
+    std::string name;
+    double create_ms = 0.0;
+    bool ok = false;
+    uint32_t local_size = 0;  // As loaded
+    bool tuned = false;       // A stored AutoTuner choice was applied
+    bool tuned_now = false;   // Tuned by this call; create_ms includes the sweep
+};
+
+/// Load every kernel in @p specs into @p launcher, timing each pipeline.
+/// @param tuner choices to apply; the primary device's by default
+inline std::vector<PreloadResult> preload(KernelLauncher& launcher, const std::vector<KernelSpec>& specs,
+                                          AutoTuner& tuner = primary_tuner()) {
+    std::vector<PreloadResult> results;
+    results.reserve(specs.size());
+    for (const auto& spec : specs) {
+        const std::vector<uint32_t> spirv(spec.spirv, spec.spirv + spec.spirv_size);
+        auto start = std::chrono::high_resolution_clock::now();
+        const bool tune = autotune_on_first_use();
+        TuneResult r = tune ? tuner.load_tuned(launcher, spec.name, spirv) : tuner.load_choice(launcher, spec.name, spirv);
+        auto end = std::chrono::high_resolution_clock::now();
+        results.push_back({spec.name, std::chrono::duration<double, std::milli>(end - start).count(), r.ok(),
+                           r.local_size, r.cached, tune && !r.cached});
+    }
+    return results;
+}
+
+inline bool all_loaded(const std::vector<PreloadResult>& results) {
+    for (const auto& r : results) {
+        if (!r.ok) return false;
+    }
+    return true;
+}
+
+inline double total_create_ms(const std::vector<PreloadResult>& results) {
+    double total = 0.0;
+    for (const auto& r : results) total += r.create_ms;
+    return total;
+}
+
+} // namespace parallax::samples
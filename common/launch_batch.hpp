@@ -0,0 +1,85 @@
+/**
+ * @file launch_batch.hpp
+ * @brief Queue a fixed launch sequence on an AsyncLauncher as one job
+ *
+ * Iterative loops issue the same launches with the same pointers on every
+ * iteration. A LaunchBatch holds that sequence, built once, and submit()
+ * hands all of it to an AsyncLauncher as a single job:
+ *
+ *   parallax::samples::LaunchBatch batch;
+ *   batch.launch("vector_multiply", a, n, 2.0f);
+ *   batch.launch("vector_multiply", b, n, 0.5f);
+ *   for (int it = 0; it < iterations; it++) batch.submit(async).wait();
+ *
+ * The job still issues one KernelLauncher::launch per launch, which is all
+ * the runtime offers (no recorded command buffer to resubmit), so the GPU
+ * side costs what eager launches cost. What batching saves is the host
+ * side: one queue handoff and one completion event per submit instead of
+ * one per launch. Against a plain synchronous launch loop it saves nothing;
+ * use it to take a sequence off the calling thread, not to speed it up.
+ *
+ * Pointers are not owned and must stay valid while the batch is queued.
+ */
+
+#pragma once
+
+#include <parallax/kernel_launcher.hpp>
+#include "common/async_launcher.hpp"
+#include "common/metrics.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace parallax::samples {
+
+class LaunchBatch {
+public:
+    struct Step {
+        std::string kernel;             // Empty for host steps
+        float* data = nullptr;
+        size_t n = 0;
+        float arg = 0.0f;
+        std::function<bool()> host;     // Host step between launches
+    };
+
+    /// Append launcher.launch(kernel, data, n, arg).
+    void launch(std::string kernel, float* data, size_t n, float arg) {
+        steps_.push_back({std::move(kernel), data, n, arg, {}});
+    }
+
+    /// Append host work (returning bool) that runs in sequence.
+    void host(std::function<bool()> fn) {
+        steps_.push_back({{}, nullptr, 0, 0.0f, std::move(fn)});
+    }
+
+    /// Queue the sequence @p times over on @p async's launcher as one job,
+    /// stopping at the first failure. The batch must outlive the returned
+    /// event.
+    LaunchEvent submit(AsyncLauncher& async, int times = 1) const {
+        return async.submit([this, &launcher = async.launcher(), times] {
+            for (int t = 0; t < times; t++) {
+                for (const Step& step : steps_) {
+                    if (!run(launcher, step)) return false;
+                }
+            }
+            return true;
+        });
+    }
+
+    size_t size() const { return steps_.size(); }
+    bool empty() const { return steps_.empty(); }
+    const std::vector<Step>& steps() const { return steps_; }
+
+private:
+    static bool run(KernelLauncher& launcher, const Step& step) {
+        if (step.host) return step.host();
+        return counted_launch(launcher, step.kernel, step.data, step.n, step.arg);
+    }
+
+    std::vector<Step> steps_;
+};
+
+} // namespace parallax::samples
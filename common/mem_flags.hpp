@@ -0,0 +1,66 @@
+/**
+ * @file mem_flags.hpp
+ * @brief Residency hints for the flags argument of parallax_umalloc
+ *
+ *   PARALLAX_MEM_DEVICE_ONLY       device-local; the host never dereferences
+ *                                  the pointer, so there is no host copy and
+ *                                  no coherence tracking
+ *   PARALLAX_MEM_HOST_READ_MOSTLY  host-cached placement for results the
+ *                                  host reads repeatedly and rarely writes
+ *   PARALLAX_MEM_STREAMING         written once by the host, read once by
+ *                                  the device: write-combined upload path,
+ *                                  never read back
+ *   PARALLAX_MEM_EXPLICIT_DIRTY    no implicit host-write tracking: only
+ *                                  ranges passed to parallax_umark_dirty
+ *                                  are uploaded before a launch
+ *
+ * The values come from parallax/runtime.h when the runtime defines them,
+ * and placing the allocation accordingly is up to its MemoryManager.
+ * Against a runtime without them a hint's flags are 0 and supported is
+ * false, so callers can skip a comparison instead of measuring flags 0
+ * twice.
+ */
+
+#pragma once
+
+#include <parallax/runtime.h>
+
+namespace parallax::samples {
+
+struct MemHint {
+    const char* name;
+    const char* short_name;  // Fits the harness variant column
+    unsigned flags;
+    bool supported;
+};
+
+#ifdef PARALLAX_MEM_DEVICE_ONLY
+inline constexpr MemHint kMemDeviceOnly{"PARALLAX_MEM_DEVICE_ONLY", "dev", PARALLAX_MEM_DEVICE_ONLY, true};
+#else
+inline constexpr MemHint kMemDeviceOnly{"PARALLAX_MEM_DEVICE_ONLY", "dev", 0, false};
+#endif
+
+#ifdef PARALLAX_MEM_HOST_READ_MOSTLY
+inline constexpr MemHint kMemHostReadMostly{"PARALLAX_MEM_HOST_READ_MOSTLY", "read", PARALLAX_MEM_HOST_READ_MOSTLY, true};
+#else
+inline constexpr MemHint kMemHostReadMostly{"PARALLAX_MEM_HOST_READ_MOSTLY", "read", 0, false};
+#endif
+
+#ifdef PARALLAX_MEM_STREAMING
+inline constexpr MemHint kMemStreaming{"PARALLAX_MEM_STREAMING", "strm", PARALLAX_MEM_STREAMING, true};
+#else
+inline constexpr MemHint kMemStreaming{"PARALLAX_MEM_STREAMING", "strm", 0, false};
+#endif
+
+#ifdef PARALLAX_MEM_EXPLICIT_DIRTY
+inline constexpr MemHint kMemExplicitDirty{"PARALLAX_MEM_EXPLICIT_DIRTY", "xdty", PARALLAX_MEM_EXPLICIT_DIRTY, true};
+#else
+inline constexpr MemHint kMemExplicitDirty{"PARALLAX_MEM_EXPLICIT_DIRTY", "xdty", 0, false};
+#endif
+
+/// False for memory the host must not read or write.
+inline bool host_accessible(unsigned flags) {
+    return !kMemDeviceOnly.supported || (flags & kMemDeviceOnly.flags) == 0;
+}
+
+} // namespace parallax::samples
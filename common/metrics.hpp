@@ -0,0 +1,289 @@
+/**
+ * @file metrics.hpp
+ * @brief Always-on counters for launches, bytes moved, cache hits and CPU fallbacks
+ *
+ * A std::execution::par call that silently ran on the CPU looks the same
+ * as one that ran on the GPU, only slower. metrics() is a process-wide set
+ * of relaxed atomic counters that the sample helpers bump as they work:
+ *
+ *   launches / dispatch time  per kernel, via counted_launch() (what
+ *                             AsyncLauncher, LaunchBatch and MultiDevice
+ *                             call)
+ *   CPU fallbacks             per kernel, with the last reason: a call
+ *                             that wanted the GPU and ran on the CPU
+ *                             (run_when_ready() before the kernel compiled)
+ *   CPU / GPU picks           per kernel, DispatchPolicy::choose() decisions;
+ *                             a cost-model CPU pick is not a fallback
+ *   staging bytes             host memcpy into and out of unified staging
+ *                             buffers by HostRange and stream_transform(),
+ *                             not device transfers
+ *   kernel cache              memory / disk hits and misses of KernelCache
+ *   pool                      UnifiedPool requests, hits and bytes in use
+ *
+ * snapshot() copies them out. print_metrics() prints it when anything was
+ * counted (PARALLAX_METRICS=0 silences it); BenchHarness::finish() calls
+ * it, and samples without a harness call it before they return.
+ *
+ * Coherence transfers (the real H2D / D2H traffic) and par calls inside
+ * the runtime are only visible to the runtime itself. When it exports
+ * parallax_get_stats (probed by CMake as PARALLAX_HAS_GET_STATS) its
+ * totals are reported next to the samples' own counters. The assumed ABI is
+ *
+ *   typedef struct { uint64_t launches, dispatch_ns, h2d_bytes, d2h_bytes,
+ *                    cpu_fallbacks; } parallax_stats_t;
+ *   int parallax_get_stats(parallax_stats_t* out);  // 0 on success
+ */
+
+#pragma once
+
+#ifdef PARALLAX_HAS_GET_STATS
+#include <parallax/runtime.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace parallax::samples {
+
+struct KernelMetrics {
+    uint64_t launches = 0;
+    uint64_t dispatch_ns = 0;
+    uint64_t cpu_fallbacks = 0;
+    std::string fallback_reason;  // Most recent
+    uint64_t cpu_picks = 0;       // DispatchPolicy decisions
+    uint64_t gpu_picks = 0;
+
+    double total_ms() const { return dispatch_ns / 1e6; }
+    double avg_ms() const { return launches ? total_ms() / launches : 0.0; }
+};
+
+struct MetricsSnapshot {
+    std::map<std::string, KernelMetrics> kernels;
+    uint64_t staged_in_bytes = 0;   // Host memcpy into staging buffers
+    uint64_t staged_out_bytes = 0;  // Host memcpy back out of them
+    uint64_t cache_memory_hits = 0;
+    uint64_t cache_disk_hits = 0;
+    uint64_t cache_misses = 0;
+    uint64_t pool_requests = 0;
+    uint64_t pool_hits = 0;
+    uint64_t pool_bytes_in_use = 0;
+    uint64_t pool_peak_bytes = 0;
+
+    // From parallax_get_stats, when the runtime has it
+    bool runtime_known = false;
+    uint64_t runtime_launches = 0;
+    uint64_t runtime_dispatch_ns = 0;
+    uint64_t runtime_h2d_bytes = 0;
+    uint64_t runtime_d2h_bytes = 0;
+    uint64_t runtime_cpu_fallbacks = 0;
+
+    uint64_t cache_lookups() const { return cache_memory_hits + cache_disk_hits + cache_misses; }
+    double cache_hit_rate() const {
+        return cache_lookups() ? double(cache_memory_hits + cache_disk_hits) / cache_lookups() : 0.0;
+    }
+    double pool_hit_rate() const { return pool_requests ? double(pool_hits) / pool_requests : 0.0; }
+
+    bool empty() const {
+        return kernels.empty() && staged_in_bytes == 0 && staged_out_bytes == 0 && cache_lookups() == 0 &&
+               pool_requests == 0 && runtime_launches == 0 && runtime_cpu_fallbacks == 0;
+    }
+
+    void print(std::ostream& out = std::cout) const {
+        auto mb = [](uint64_t bytes) { return bytes / double(1 << 20); };
+        std::ios::fmtflags flags(out.flags());
+        out << std::endl << "Runtime metrics:" << std::endl << std::fixed;
+        if (!kernels.empty()) {
+            out << std::left << "  " << std::setw(24) << "Kernel" << std::right << std::setw(10) << "Launches"
+                << std::setw(12) << "Total ms" << std::setw(10) << "Avg ms" << std::setw(10) << "Fallback"
+                << std::setw(16) << "Picked CPU/GPU" << std::endl;
+            for (const auto& [name, k] : kernels) {
+                out << std::left << "  " << std::setw(24) << name << std::right << std::setw(10) << k.launches
+                    << std::setprecision(2) << std::setw(12) << k.total_ms() << std::setprecision(3)
+                    << std::setw(10) << k.avg_ms() << std::setw(10) << k.cpu_fallbacks << std::setw(16)
+                    << (std::to_string(k.cpu_picks) + "/" + std::to_string(k.gpu_picks)) << std::endl;
+                if (k.cpu_fallbacks) out << "    last fallback: " << k.fallback_reason << std::endl;
+            }
+        }
+        out << std::setprecision(1);
+        if (staged_in_bytes || staged_out_bytes) {
+            out << "  Staging copies: " << mb(staged_in_bytes) << " MB in, " << mb(staged_out_bytes)
+                << " MB out (host memcpy)" << std::endl;
+        }
+        if (cache_lookups()) {
+            out << "  Kernel cache: " << 100.0 * cache_hit_rate() << "% hits (" << cache_memory_hits
+                << " memory, " << cache_disk_hits << " disk, " << cache_misses << " compiled)" << std::endl;
+        }
+        if (pool_requests) {
+            out << "  Pool: " << pool_requests << " requests, " << 100.0 * pool_hit_rate() << "% reused, "
+                << mb(pool_bytes_in_use) << " MB in use (peak " << mb(pool_peak_bytes) << " MB)" << std::endl;
+        }
+        if (runtime_known) {
+            out << "  Runtime: " << runtime_launches << " launches, " << std::setprecision(2)
+                << runtime_dispatch_ns / 1e6 << " ms dispatch, " << std::setprecision(1)
+                << mb(runtime_h2d_bytes) << " MB H2D, " << mb(runtime_d2h_bytes) << " MB D2H, "
+                << runtime_cpu_fallbacks << " CPU fallbacks" << std::endl;
+        }
+        out.flags(flags);
+    }
+};
+
+class Metrics {
+public:
+    /// Process-wide counters. Never destroyed, so helpers may still count
+    /// from static destructors.
+    static Metrics& instance() {
+        static Metrics* metrics = new Metrics();
+        return *metrics;
+    }
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    void add_launch(std::string_view kernel, uint64_t ns) {
+        Counters& c = counters(kernel);
+        c.launches.fetch_add(1, std::memory_order_relaxed);
+        c.dispatch_ns.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    /// A call that wanted the GPU ran on the CPU instead.
+    void add_fallback(std::string_view kernel, std::string_view reason) {
+        Counters& c = counters(kernel);
+        c.cpu_fallbacks.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(c.reason_mutex);
+        c.reason.assign(reason);
+    }
+
+    /// A dispatch policy chose a backend for one call.
+    void add_decision(std::string_view kernel, bool gpu) {
+        Counters& c = counters(kernel);
+        (gpu ? c.gpu_picks : c.cpu_picks).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void add_staged_in(uint64_t bytes) { staged_in_bytes_.fetch_add(bytes, std::memory_order_relaxed); }
+    void add_staged_out(uint64_t bytes) { staged_out_bytes_.fetch_add(bytes, std::memory_order_relaxed); }
+
+    void add_cache_memory_hit() { cache_memory_hits_.fetch_add(1, std::memory_order_relaxed); }
+    void add_cache_disk_hit() { cache_disk_hits_.fetch_add(1, std::memory_order_relaxed); }
+    void add_cache_miss() { cache_misses_.fetch_add(1, std::memory_order_relaxed); }
+
+    void add_pool_request(bool hit) {
+        pool_requests_.fetch_add(1, std::memory_order_relaxed);
+        if (hit) pool_hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @p delta bytes handed out (positive) or returned (negative) by a pool.
+    void add_pool_in_use(int64_t delta) {
+        uint64_t now = pool_in_use_.fetch_add(static_cast<uint64_t>(delta), std::memory_order_relaxed) + delta;
+        uint64_t peak = pool_peak_.load(std::memory_order_relaxed);
+        while (now > peak && !pool_peak_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+    }
+
+    MetricsSnapshot snapshot() const {
+        MetricsSnapshot s;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [name, c] : kernels_) {
+                KernelMetrics& k = s.kernels[name];
+                k.launches = c.launches.load(std::memory_order_relaxed);
+                k.dispatch_ns = c.dispatch_ns.load(std::memory_order_relaxed);
+                k.cpu_fallbacks = c.cpu_fallbacks.load(std::memory_order_relaxed);
+                k.cpu_picks = c.cpu_picks.load(std::memory_order_relaxed);
+                k.gpu_picks = c.gpu_picks.load(std::memory_order_relaxed);
+                std::lock_guard<std::mutex> reason_lock(c.reason_mutex);
+                k.fallback_reason = c.reason;
+            }
+        }
+        s.staged_in_bytes = staged_in_bytes_.load(std::memory_order_relaxed);
+        s.staged_out_bytes = staged_out_bytes_.load(std::memory_order_relaxed);
+        s.cache_memory_hits = cache_memory_hits_.load(std::memory_order_relaxed);
+        s.cache_disk_hits = cache_disk_hits_.load(std::memory_order_relaxed);
+        s.cache_misses = cache_misses_.load(std::memory_order_relaxed);
+        s.pool_requests = pool_requests_.load(std::memory_order_relaxed);
+        s.pool_hits = pool_hits_.load(std::memory_order_relaxed);
+        s.pool_bytes_in_use = pool_in_use_.load(std::memory_order_relaxed);
+        s.pool_peak_bytes = pool_peak_.load(std::memory_order_relaxed);
+#ifdef PARALLAX_HAS_GET_STATS
+        parallax_stats_t rt{};
+        if (parallax_get_stats(&rt) == 0) {
+            s.runtime_known = true;
+            s.runtime_launches = rt.launches;
+            s.runtime_dispatch_ns = rt.dispatch_ns;
+            s.runtime_h2d_bytes = rt.h2d_bytes;
+            s.runtime_d2h_bytes = rt.d2h_bytes;
+            s.runtime_cpu_fallbacks = rt.cpu_fallbacks;
+        }
+#endif
+        return s;
+    }
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> launches{0};
+        std::atomic<uint64_t> dispatch_ns{0};
+        std::atomic<uint64_t> cpu_fallbacks{0};
+        std::atomic<uint64_t> cpu_picks{0};
+        std::atomic<uint64_t> gpu_picks{0};
+        mutable std::mutex reason_mutex;
+        std::string reason;  // Guarded by reason_mutex
+    };
+
+    Metrics() = default;
+
+    // Entries are never erased, so pointers stay valid. Each thread keeps
+    // its own name -> counters map: after a thread's first use of a kernel
+    // name, lookups take no lock and allocate nothing
+    Counters& counters(std::string_view kernel) {
+        thread_local std::map<std::string, Counters*, std::less<>> local;
+        auto it = local.find(kernel);
+        if (it != local.end()) return *it->second;
+        Counters* c;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            c = &kernels_.try_emplace(std::string(kernel)).first->second;
+        }
+        local.emplace(std::string(kernel), c);
+        return *c;
+    }
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Counters, std::less<>> kernels_;
+    std::atomic<uint64_t> staged_in_bytes_{0};
+    std::atomic<uint64_t> staged_out_bytes_{0};
+    std::atomic<uint64_t> cache_memory_hits_{0};
+    std::atomic<uint64_t> cache_disk_hits_{0};
+    std::atomic<uint64_t> cache_misses_{0};
+    std::atomic<uint64_t> pool_requests_{0};
+    std::atomic<uint64_t> pool_hits_{0};
+    std::atomic<uint64_t> pool_in_use_{0};
+    std::atomic<uint64_t> pool_peak_{0};
+};
+
+inline Metrics& metrics() { return Metrics::instance(); }
+
+/// launcher.launch(kernel, data, n, arg), counted and timed under @p kernel.
+template<typename Launcher>
+bool counted_launch(Launcher& launcher, const std::string& kernel, float* data, size_t n, float arg) {
+    auto start = std::chrono::steady_clock::now();
+    bool ok = launcher.launch(kernel, data, n, arg);
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    metrics().add_launch(kernel, static_cast<uint64_t>(ns.count()));
+    return ok;
+}
+
+/// Print the snapshot unless nothing was counted or PARALLAX_METRICS=0.
+inline void print_metrics(std::ostream& out = std::cout) {
+    const char* env = std::getenv("PARALLAX_METRICS");
+    if (env && std::string(env) == "0") return;
+    MetricsSnapshot s = metrics().snapshot();
+    if (!s.empty()) s.print(out);
+}
+
+} // namespace parallax::samples
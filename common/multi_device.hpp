@@ -0,0 +1,201 @@
+/**
+ * @file multi_device.hpp
+ * @brief Split one element-wise launch across several GPUs, and partition reductions
+ *
+ * MultiDevice opens one KernelLauncher per GPU. It measures each lane's
+ * throughput with calibrate(), then partitions [0, n) in proportion to
+ * it, so a GPU that is twice as fast gets twice the elements. Before
+ * launching, each slice is prefetched to its device, which gives a single
+ * parallax_umalloc buffer per-device residency. Every lane after the first
+ * dispatches from its own thread.
+ *
+ * Per-device backends come from parallax::get_device_backend(int) /
+ * get_device_memory_manager(int) when the runtime provides them
+ * (PARALLAX_HAS_DEVICE_BACKENDS, probed at configure time). Otherwise the
+ * global backend is the only lane.
+ */
+
+#pragma once
+
+#include <parallax/runtime.hpp>
+#include <parallax/kernel_launcher.hpp>
+#include "common/device_info.hpp"
+#include "common/dirty_ranges.hpp"
+#include "common/kernel_preload.hpp"
+#include "common/metrics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parallax::samples {
+
+/// Split @p n elements in proportion to @p weights. Boundaries are rounded
+/// to @p align elements, and the last slice takes the remainder.
+inline std::vector<std::pair<size_t, size_t>> partition(size_t n, const std::vector<double>& weights,
+                                                        size_t align = 1024) {
+    std::vector<std::pair<size_t, size_t>> slices;  // (offset, count)
+    if (weights.empty()) return slices;
+    const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    size_t offset = 0;
+    double cumulative = 0.0;
+    for (size_t i = 0; i < weights.size(); i++) {
+        cumulative += weights[i];
+        size_t end = n;
+        if (i + 1 < weights.size()) {
+            end = static_cast<size_t>(n * (total > 0.0 ? cumulative / total : double(i + 1) / weights.size()));
+            end = std::clamp(end / align * align, offset, n);
+        }
+        slices.emplace_back(offset, end - offset);
+        offset = end;
+    }
+    return slices;
+}
+
+struct DeviceLane {
+    DeviceInfo info;
+    int device = 0;
+    VulkanBackend* backend = nullptr;
+    MemoryManager* memory = nullptr;
+    std::unique_ptr<KernelLauncher> launcher;
+    double elements_per_ms = 1.0;  // Measured by calibrate()
+};
+
+class MultiDevice {
+public:
+    /// Open up to @p max_devices lanes, in Vulkan enumeration order.
+    explicit MultiDevice(size_t max_devices = std::numeric_limits<size_t>::max()) {
+#ifdef PARALLAX_HAS_DEVICE_BACKENDS
+        auto devices = enumerate_devices();
+        for (size_t i = 0; i < devices.size() && lanes_.size() < max_devices; i++) {
+            int index = static_cast<int>(i);
+            VulkanBackend* backend = parallax::get_device_backend(index);
+            MemoryManager* memory = parallax::get_device_memory_manager(index);
+            if (!backend || !memory) continue;
+            add_lane(devices[i], index, backend, memory);
+        }
+#else
+        VulkanBackend* backend = parallax::get_global_backend();
+        MemoryManager* memory = parallax::get_global_memory_manager();
+        if (backend && memory && max_devices > 0) add_lane(primary_device(), 0, backend, memory);
+#endif
+    }
+
+    size_t size() const { return lanes_.size(); }
+    const std::vector<DeviceLane>& lanes() const { return lanes_; }
+
+    /// Build every pipeline in @p specs on every lane, with that lane's
+    /// tuned workgroup sizes (tuning on the lane's own device on first use).
+    bool preload(const std::vector<KernelSpec>& specs) {
+        bool ok = !lanes_.empty();
+        for (auto& lane : lanes_) {
+            ok = all_loaded(samples::preload(*lane.launcher, specs, tuner_for(lane.info, lane.backend, lane.memory))) && ok;
+        }
+        return ok;
+    }
+
+    /// Time @p kernel over @p n elements of scratch on each lane in turn
+    /// (best of three after a warmup). @p identity_arg must leave the data
+    /// unchanged.
+    bool calibrate(const std::string& kernel, float identity_arg, size_t n = 4 << 20) {
+        float* scratch = static_cast<float*>(parallax_umalloc(n * sizeof(float), 0));
+        if (!scratch) return false;
+        std::fill(scratch, scratch + n, 1.0f);
+        bool ok = true;
+        for (auto& lane : lanes_) {
+            ok = lane.launcher->launch(kernel, scratch, n, identity_arg) && ok;
+            double best = std::numeric_limits<double>::max();
+            for (int rep = 0; rep < 3; rep++) {
+                auto start = std::chrono::high_resolution_clock::now();
+                ok = lane.launcher->launch(kernel, scratch, n, identity_arg) && ok;
+                auto end = std::chrono::high_resolution_clock::now();
+                best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+            }
+            lane.elements_per_ms = n / std::max(best, 1e-6);
+        }
+        parallax_ufree(scratch);
+        return ok;
+    }
+
+    /// Throughput weights of the first @p lanes lanes.
+    std::vector<double> weights(size_t lanes) const {
+        std::vector<double> w;
+        for (size_t i = 0; i < std::min(lanes, lanes_.size()); i++) w.push_back(lanes_[i].elements_per_ms);
+        return w;
+    }
+
+    /// Prefetch each lane's slice of @p data to its device.
+    void place(float* data, size_t n, size_t lanes) const {
+        auto slices = partition(n, weights(lanes));
+        for (size_t i = 0; i < slices.size(); i++) {
+            prefetch(data + slices[i].first, slices[i].second * sizeof(float), lanes_[i].device);
+        }
+    }
+
+    /// launch(kernel, data, n, arg), split across the first @p lanes lanes.
+    bool launch(const std::string& kernel, float* data, size_t n, float arg,
+                size_t lanes = std::numeric_limits<size_t>::max()) {
+        return run(n, lanes, [&](DeviceLane& lane, size_t offset, size_t count) {
+            return counted_launch(*lane.launcher, kernel, data + offset, count, arg);
+        }, data);
+    }
+
+    /// Partitioned reduction. @p partial(lane, offset, count) reduces one
+    /// slice, on lane 0's calling thread or that lane's worker thread, and
+    /// decides where the work runs: MultiDevice launches nothing itself, and
+    /// the samples ship no reduction kernel. Partials are combined on the
+    /// host, in lane order.
+    template<typename T, typename Partial, typename Combine>
+    T reduce(size_t n, T init, Partial&& partial, Combine&& combine,
+             size_t lanes = std::numeric_limits<size_t>::max()) {
+        std::vector<T> partials(std::min(lanes, lanes_.size()), init);
+        run(n, lanes, [&](DeviceLane& lane, size_t offset, size_t count) {
+            size_t slot = static_cast<size_t>(&lane - lanes_.data());
+            partials[slot] = partial(lane, offset, count);
+            return true;
+        });
+        T result = init;
+        for (const T& p : partials) result = combine(result, p);
+        return result;
+    }
+
+private:
+    void add_lane(const DeviceInfo& info, int device, VulkanBackend* backend, MemoryManager* memory) {
+        DeviceLane lane;
+        lane.info = info;
+        lane.device = device;
+        lane.backend = backend;
+        lane.memory = memory;
+        lane.launcher = std::make_unique<KernelLauncher>(backend, memory);
+        lanes_.push_back(std::move(lane));
+    }
+
+    // Lane 0 runs on the calling thread, the others on one thread each
+    template<typename Body>
+    bool run(size_t n, size_t lanes, Body&& body, float* residency = nullptr) {
+        lanes = std::min(lanes, lanes_.size());
+        if (lanes == 0) return false;
+        if (residency) place(residency, n, lanes);
+        auto slices = partition(n, weights(lanes));
+        std::vector<char> ok(lanes, 1);
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < lanes; i++) {
+            if (slices[i].second == 0) continue;
+            workers.emplace_back([&, i] { ok[i] = body(lanes_[i], slices[i].first, slices[i].second); });
+        }
+        if (slices[0].second > 0) ok[0] = body(lanes_[0], slices[0].first, slices[0].second);
+        for (auto& w : workers) w.join();
+        return std::all_of(ok.begin(), ok.end(), [](char c) { return c != 0; });
+    }
+
+    std::vector<DeviceLane> lanes_;
+};
+
+} // namespace parallax::samples
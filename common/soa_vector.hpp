@@ -0,0 +1,311 @@
+/**
+ * @file soa_vector.hpp
+ * @brief Structure-of-arrays container whose elements read like structs
+ *
+ * A std::vector<Particle> puts x, y, z, vx, ... of one particle next to
+ * each other, so a kernel reading only x loads one float out of every
+ * sizeof(Particle) bytes. soa_vector keeps each listed field in its own
+ * parallax_umalloc buffer instead:
+ *
+ *   struct Particle { float x, y, z, vx, vy, vz, mass; };
+ *   using Particles = parallax::samples::soa_vector<Particle,
+ *       &Particle::x, &Particle::y, &Particle::z,
+ *       &Particle::vx, &Particle::vy, &Particle::vz, &Particle::mass>;
+ *
+ *   Particles p(n);
+ *   std::for_each(std::execution::par, p.begin(), p.end(), [](auto q) {
+ *       q[&Particle::x] += q[&Particle::vx];
+ *   });
+ *
+ * Iterators yield a proxy `reference` (take it by value): q[&T::member]
+ * is a reference into that field's array, and T conversion / assignment
+ * gather and scatter a whole element. Consecutive elements of one field
+ * are adjacent, so per-field accesses coalesce. field<&T::m>() returns the
+ * raw array, which is the start of its own allocation and can be passed
+ * to KernelLauncher::launch or an offloaded algorithm directly.
+ *
+ * Iterators and proxies carry the field base pointers by value, not a
+ * pointer to the soa_vector, so they can be copied into an offloaded
+ * kernel. Fields not listed are not stored: q[&T::unlisted] does not
+ * compile, and conversion to T leaves them value-initialized.
+ */
+
+#pragma once
+
+#include <parallax/runtime.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace parallax::samples {
+
+template<typename M> struct member_traits;
+template<typename C, typename V> struct member_traits<V C::*> {
+    using class_type = C;
+    using value_type = V;
+};
+
+template<typename T, auto... Fields>
+class soa_vector {
+    static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+    static_assert((std::is_same_v<typename member_traits<decltype(Fields)>::class_type, T> && ...),
+                  "every field must be a data member of T");
+    static_assert((std::is_trivially_copyable_v<typename member_traits<decltype(Fields)>::value_type> && ...),
+                  "fields are stored in unified memory and must be trivially copyable");
+
+    template<auto F> using field_t = typename member_traits<decltype(F)>::value_type;
+    using arrays = std::tuple<field_t<Fields>*...>;
+    template<size_t I> using field_at = std::remove_pointer_t<std::tuple_element_t<I, arrays>>;
+
+    template<auto F, size_t I = 0, auto First, auto... Rest>
+    static constexpr size_t index_in() {
+        if constexpr (std::is_same_v<decltype(F), decltype(First)>) {
+            if (F == First) return I;
+        }
+        if constexpr (sizeof...(Rest) > 0) return index_in<F, I + 1, Rest...>();
+        else return sizeof...(Fields);
+    }
+
+    template<auto F, typename V>
+    static constexpr bool is_field(V T::* member) {
+        if constexpr (std::is_same_v<field_t<F>, V>) return member == F;
+        else return false;
+    }
+
+    template<typename V>
+    static constexpr size_t index_of(V T::* member) {
+        size_t index = sizeof...(Fields), i = 0;
+        ((index = index == sizeof...(Fields) && is_field<Fields>(member) ? i : index, i++), ...);
+        return index;
+    }
+
+    // Whether field I is the first with its type, so each type gets one
+    // operator[] overload
+    template<size_t I, size_t... J>
+    static constexpr bool first_of_type(std::index_sequence<J...>) {
+        return !((J < I && std::is_same_v<field_at<J>, field_at<I>>) || ...);
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    static constexpr size_t field_count = sizeof...(Fields);
+
+    /// Argument of q[&T::member]. The consteval constructor makes an
+    /// unlisted member a compile error rather than a null reference.
+    template<typename V>
+    struct listed_member {
+        size_t index;
+        consteval listed_member(V T::* member) : index(index_of(member)) {
+            if (index == field_count) throw "member is not a field of this soa_vector";
+        }
+    };
+
+    class reference;
+
+private:
+    template<size_t I>
+    struct typed_subscript {
+        field_at<I>& operator[](listed_member<field_at<I>> member) const {
+            return static_cast<const reference&>(*this).template at<field_at<I>>(member.index);
+        }
+    };
+    template<size_t I>
+    struct no_subscript {
+        struct never {
+            explicit never() = default;
+        };
+        void operator[](never) const = delete;
+    };
+    template<size_t I>
+    using subscript = std::conditional_t<first_of_type<I>(std::make_index_sequence<sizeof...(Fields)>{}),
+                                         typed_subscript<I>, no_subscript<I>>;
+
+    template<typename Seq> struct subscripts;
+    template<size_t... I>
+    struct subscripts<std::index_sequence<I...>> : subscript<I>... {
+        using subscript<I>::operator[]...;
+    };
+
+public:
+    /// Proxy for element i: the field base pointers by value plus the
+    /// index, so it stays valid wherever the arrays are (no pointer back
+    /// to the host-side container).
+    class reference : public subscripts<std::make_index_sequence<sizeof...(Fields)>> {
+    public:
+        template<auto F>
+        field_t<F>& get() const {
+            static_assert(index_in<F, 0, Fields...>() < field_count, "member is not a field of this soa_vector");
+            return std::get<index_in<F, 0, Fields...>()>(data_)[i_];
+        }
+
+        /// q[&T::member]: the member of this element, in its field array.
+        using subscripts<std::make_index_sequence<sizeof...(Fields)>>::operator[];
+
+        size_t index() const { return i_; }
+
+        operator T() const {
+            T value{};
+            ((value.*Fields = get<Fields>()), ...);
+            return value;
+        }
+
+        const reference& operator=(const T& value) const {
+            ((get<Fields>() = value.*Fields), ...);
+            return *this;
+        }
+
+        /// Copies the element, not the proxy (`*a = *b` moves values).
+        const reference& operator=(const reference& other) const { return *this = T(other); }
+
+        friend void swap(const reference& a, const reference& b) {
+            T tmp = a;
+            a = b;
+            b = tmp;
+        }
+
+    private:
+        friend class soa_vector;
+        template<size_t> friend struct typed_subscript;
+        reference(const arrays& data, size_t i) : data_(data), i_(i) {}
+
+        template<typename V>
+        V& at(size_t index) const {
+            V* result = nullptr;
+            std::apply([&](auto*... array) {
+                size_t i = 0;
+                ((set_if<V>(result, array, i++ == index)), ...);
+            }, data_);
+            return *result;  // index came from listed_member, so it names a V field
+        }
+
+        template<typename V, typename U>
+        void set_if(V*& result, U* array, bool match) const {
+            if constexpr (std::is_same_v<U, V>) {
+                if (match) result = &array[i_];
+            }
+        }
+
+        arrays data_;
+        size_t i_;
+    };
+
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = soa_vector::reference;
+        using pointer = void;
+
+        iterator() = default;
+
+        reference operator*() const { return reference(data_, i_); }
+        reference operator[](difference_type d) const { return reference(data_, i_ + d); }
+
+        iterator& operator++() { ++i_; return *this; }
+        iterator operator++(int) { iterator t = *this; ++i_; return t; }
+        iterator& operator--() { --i_; return *this; }
+        iterator operator--(int) { iterator t = *this; --i_; return t; }
+        iterator& operator+=(difference_type d) { i_ += d; return *this; }
+        iterator& operator-=(difference_type d) { i_ -= d; return *this; }
+        friend iterator operator+(iterator it, difference_type d) { return it += d; }
+        friend iterator operator+(difference_type d, iterator it) { return it += d; }
+        friend iterator operator-(iterator it, difference_type d) { return it -= d; }
+        friend difference_type operator-(const iterator& a, const iterator& b) {
+            return static_cast<difference_type>(a.i_) - static_cast<difference_type>(b.i_);
+        }
+        friend bool operator==(const iterator& a, const iterator& b) { return a.i_ == b.i_; }
+        friend auto operator<=>(const iterator& a, const iterator& b) { return a.i_ <=> b.i_; }
+
+    private:
+        friend class soa_vector;
+        iterator(const arrays& data, size_t i) : data_(data), i_(i) {}
+
+        arrays data_{};
+        size_t i_ = 0;
+    };
+
+    explicit soa_vector(size_t n, const T& value = T{}) : size_(n) {
+        allocate(std::index_sequence_for<decltype(Fields)...>{});
+        for (size_t i = 0; i < n; i++) (*this)[i] = value;
+    }
+
+    /// Transpose an AoS range in.
+    soa_vector(const T* first, size_t n) : size_(n) {
+        allocate(std::index_sequence_for<decltype(Fields)...>{});
+        for (size_t i = 0; i < n; i++) (*this)[i] = first[i];
+    }
+
+    ~soa_vector() { release(); }
+
+    soa_vector(const soa_vector&) = delete;
+    soa_vector& operator=(const soa_vector&) = delete;
+
+    soa_vector(soa_vector&& other) noexcept
+        : size_(std::exchange(other.size_, 0)), data_(std::exchange(other.data_, {})) {}
+
+    soa_vector& operator=(soa_vector&& other) noexcept {
+        if (this != &other) {
+            release();
+            size_ = std::exchange(other.size_, 0);
+            data_ = std::exchange(other.data_, {});
+        }
+        return *this;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    reference operator[](size_t i) { return reference(data_, i); }
+    T load(size_t i) const { return const_cast<soa_vector*>(this)->operator[](i); }
+
+    iterator begin() { return iterator(data_, 0); }
+    iterator end() { return iterator(data_, size_); }
+
+    /// Contiguous array holding member F of every element.
+    template<auto F>
+    field_t<F>* field() {
+        static_assert(index_in<F, 0, Fields...>() < field_count, "member is not a field of this soa_vector");
+        return std::get<index_in<F, 0, Fields...>()>(data_);
+    }
+    template<auto F>
+    const field_t<F>* field() const { return const_cast<soa_vector*>(this)->template field<F>(); }
+
+    /// Transpose back out to an AoS range of size() elements.
+    void store(T* out) const {
+        for (size_t i = 0; i < size_; i++) out[i] = load(i);
+    }
+
+    /// Bytes per element actually stored (sum of the listed fields).
+    static constexpr size_t element_bytes() { return (sizeof(field_t<Fields>) + ...); }
+
+private:
+    template<size_t... I>
+    void allocate(std::index_sequence<I...>) {
+        bool ok = true;
+        ((std::get<I>(data_) = static_cast<std::tuple_element_t<I, decltype(data_)>>(
+              parallax_umalloc(std::max<size_t>(1, size_) * sizeof(*std::get<I>(data_)), 0)),
+          ok = ok && std::get<I>(data_) != nullptr), ...);
+        if (!ok) {
+            release();
+            throw std::bad_alloc();
+        }
+    }
+
+    void release() {
+        std::apply([](auto*... arrays) { ((arrays ? parallax_ufree(arrays) : void()), ...); }, data_);
+        data_ = {};
+    }
+
+    size_t size_ = 0;
+    arrays data_{};
+};
+
+} // namespace parallax::samples
@@ -0,0 +1,182 @@
+/**
+ * @file spirv_inspect.hpp
+ * @brief Summarize what a generated SPIR-V kernel actually does per invocation
+ *
+ * Walks the module's instruction stream and reports the declared
+ * capabilities, the scalar widths in use, the workgroup size, and how
+ * many buffer loads and stores go through vector types (built-in inputs
+ * such as gl_GlobalInvocationID are not counted). The last one shows
+ * whether the generator emitted a vec4 (or wider-per-thread) variant or
+ * one scalar per invocation. It also counts push-constant blocks, uniform
+ * blocks and specialization constants, which is where captured values
+ * end up when they are not baked into the code.
+ *
+ * with_local_size() rewrites the workgroup size, for tuning a kernel
+ * without regenerating it.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace parallax::samples {
+
+struct SpirvInfo {
+    bool valid = false;
+    uint32_t version = 0;                 // 0x00MMmm00
+    std::vector<uint32_t> capabilities;
+    std::set<uint32_t> float_widths;
+    std::set<uint32_t> int_widths;
+    uint32_t local_size_x = 0;
+    size_t loads = 0;                     // Buffer accesses only
+    size_t stores = 0;
+    size_t vector_loads = 0;
+    size_t vector_stores = 0;
+    uint32_t widest_vector = 1;           // Components of the widest loaded/stored vector
+    size_t push_constant_blocks = 0;      // Launch parameters (captures, sizes)
+    size_t uniform_blocks = 0;            // Uniform storage class (SSBOs too, before SPIR-V 1.3)
+    size_t spec_constants = 0;            // Values fixed at pipeline creation
+
+    bool vectorized() const { return vector_loads > 0 || vector_stores > 0; }
+
+    std::string version_string() const {
+        return std::to_string((version >> 16) & 0xff) + "." + std::to_string((version >> 8) & 0xff);
+    }
+};
+
+/// Names for the capabilities relevant to type and width specialization.
+inline std::string capability_name(uint32_t capability) {
+    switch (capability) {
+        case 1: return "Shader";
+        case 9: return "Float16";
+        case 10: return "Float64";
+        case 11: return "Int64";
+        case 22: return "Int16";
+        case 39: return "Int8";
+        case 61: return "GroupNonUniform";
+        case 4433: return "StorageBuffer16BitAccess";
+        case 4448: return "StorageBuffer8BitAccess";
+        default: return std::to_string(capability);
+    }
+}
+
+inline SpirvInfo inspect_spirv(const std::vector<uint32_t>& words) {
+    constexpr uint32_t kMagic = 0x07230203;
+    enum : uint32_t {
+        OpExecutionMode = 16, OpCapability = 17, OpTypeInt = 21, OpTypeFloat = 22,
+        OpTypeVector = 23, OpTypePointer = 32, OpSpecConstantTrue = 48, OpSpecConstantFalse = 49,
+        OpSpecConstant = 50, OpSpecConstantComposite = 51, OpVariable = 59, OpLoad = 61, OpStore = 62,
+        OpAccessChain = 65, OpInBoundsAccessChain = 66,
+    };
+    constexpr uint32_t kLocalSize = 17;
+    // Storage classes that back kernel data: Uniform, StorageBuffer, PhysicalStorageBuffer
+    auto is_buffer = [](uint32_t storage) { return storage == 2 || storage == 12 || storage == 5349; };
+
+    SpirvInfo info;
+    if (words.size() < 5 || words[0] != kMagic) return info;
+    info.version = words[1];
+
+    struct PointerType { uint32_t storage; uint32_t pointee; };
+    std::map<uint32_t, uint32_t> vector_width;    // type id -> components
+    std::map<uint32_t, PointerType> pointer_type; // pointer type id -> storage class, pointee
+    std::map<uint32_t, uint32_t> pointer_of;      // pointer value id -> pointer type id
+
+    // Components of the value accessed through pointer @p id if it points
+    // into a buffer, 0 if it doesn't
+    auto buffer_access = [&](uint32_t id) -> uint32_t {
+        auto p = pointer_of.find(id);
+        if (p == pointer_of.end()) return 0;
+        auto t = pointer_type.find(p->second);
+        if (t == pointer_type.end() || !is_buffer(t->second.storage)) return 0;
+        auto v = vector_width.find(t->second.pointee);
+        return v == vector_width.end() ? 1 : v->second;
+    };
+
+    size_t i = 5;
+    while (i < words.size()) {
+        const uint32_t count = words[i] >> 16;
+        const uint32_t opcode = words[i] & 0xffff;
+        if (count == 0 || i + count > words.size()) return info;  // Malformed
+        const uint32_t* op = &words[i];
+        switch (opcode) {
+            case OpCapability: info.capabilities.push_back(op[1]); break;
+            case OpTypeInt: info.int_widths.insert(op[2]); break;
+            case OpTypeFloat: info.float_widths.insert(op[2]); break;
+            case OpTypeVector: vector_width[op[1]] = op[3]; break;
+            case OpTypePointer: pointer_type[op[1]] = {op[2], op[3]}; break;
+            case OpExecutionMode:
+                if (count >= 4 && op[2] == kLocalSize) info.local_size_x = op[3];
+                break;
+            case OpSpecConstantTrue:
+            case OpSpecConstantFalse:
+            case OpSpecConstant:
+            case OpSpecConstantComposite:
+                info.spec_constants++;
+                break;
+            case OpVariable: {
+                pointer_of[op[2]] = op[1];
+                const uint32_t storage = op[3];
+                if (storage == 9) info.push_constant_blocks++;
+                else if (storage == 2) info.uniform_blocks++;
+                break;
+            }
+            case OpAccessChain:
+            case OpInBoundsAccessChain:
+                pointer_of[op[2]] = op[1];
+                break;
+            case OpLoad:
+            case OpStore: {
+                const uint32_t width = buffer_access(opcode == OpLoad ? op[3] : op[1]);
+                if (width == 0) break;
+                (opcode == OpLoad ? info.loads : info.stores)++;
+                if (width > 1) {
+                    (opcode == OpLoad ? info.vector_loads : info.vector_stores)++;
+                    info.widest_vector = std::max(info.widest_vector, width);
+                }
+                break;
+            }
+            default: break;
+        }
+        i += count;
+    }
+    info.valid = true;
+    return info;
+}
+
+/// Copy of @p words with the workgroup size set to (@p x, 1, 1). Empty if
+/// the module has no literal LocalSize mode or pins its size through a
+/// WorkgroupSize built-in, either of which a rewrite could not change.
+inline std::vector<uint32_t> with_local_size(const std::vector<uint32_t>& words, uint32_t x) {
+    constexpr uint32_t kMagic = 0x07230203;
+    enum : uint32_t { OpExecutionMode = 16, OpDecorate = 71 };
+    constexpr uint32_t kLocalSize = 17, kBuiltIn = 11, kWorkgroupSize = 25;
+    if (words.size() < 5 || words[0] != kMagic || x == 0) return {};
+
+    std::vector<uint32_t> out = words;
+    bool patched = false;
+    size_t i = 5;
+    while (i < out.size()) {
+        const uint32_t count = out[i] >> 16;
+        const uint32_t opcode = out[i] & 0xffff;
+        if (count == 0 || i + count > out.size()) return {};
+        uint32_t* op = &out[i];
+        if (opcode == OpExecutionMode && count >= 6 && op[2] == kLocalSize) {
+            op[3] = x;
+            op[4] = 1;
+            op[5] = 1;
+            patched = true;
+        } else if (opcode == OpDecorate && count >= 4 && op[2] == kBuiltIn && op[3] == kWorkgroupSize) {
+            return {};
+        }
+        i += count;
+    }
+    return patched ? out : std::vector<uint32_t>{};
+}
+
+} // namespace parallax::samples
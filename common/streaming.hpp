@@ -0,0 +1,138 @@
+/**
+ * @file streaming.hpp
+ * @brief Chunked, multi-buffered streaming of large element-wise kernels
+ *
+ * A single launch over a 400 MB array serializes upload, compute and
+ * download. stream_transform() instead walks the input in chunks through a
+ * small ring of unified staging buffers with one thread per stage:
+ *
+ *   copy-in  (host src  -> staging[k])
+ *   compute  (kernel on staging[k-1])
+ *   copy-out (staging[k-2] -> host dst)
+ *
+ * so the three overlap once the ring is full. Device memory use is bounded
+ * by depth * chunk bytes, which lets the input be larger than the device.
+ *
+ * Only the compute thread calls @p kernel, so a single KernelLauncher may
+ * be used from it.
+ *
+ * Environment:
+ *   PARALLAX_STREAM_CHUNK_MB  default chunk size, default 64
+ */
+
+#pragma once
+
+#include <parallax/runtime.h>
+#include "common/metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <semaphore>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace parallax::samples {
+
+struct StreamingOptions {
+    size_t chunk_bytes = default_chunk_bytes();
+    int depth = 3;  // Staging buffers in the ring; 3 lets all stages overlap
+
+    static size_t default_chunk_bytes() {
+        const char* env = std::getenv("PARALLAX_STREAM_CHUNK_MB");
+        size_t mb = env ? std::strtoull(env, nullptr, 10) : 64;
+        return std::max<size_t>(mb, 1) << 20;
+    }
+};
+
+struct StreamingResult {
+    bool ok = false;
+    size_t chunks = 0;
+};
+
+/// Apply @p kernel (bool(T* chunk, size_t count)) to [src, src + n) and
+/// write the result to dst, which may equal src.
+template<typename T, typename Kernel>
+StreamingResult stream_transform(const T* src, T* dst, size_t n, Kernel&& kernel,
+                                 StreamingOptions options = {}) {
+    static_assert(std::is_trivially_copyable_v<T>, "streamed elements are copied with memcpy");
+
+    StreamingResult result;
+    const size_t chunk = std::max<size_t>(1, options.chunk_bytes / sizeof(T));
+    const size_t chunks = (n + chunk - 1) / chunk;
+    const int depth = std::max(1, options.depth);
+    result.chunks = chunks;
+
+    std::vector<T*> staging;
+    for (int i = 0; i < depth; i++) {
+        T* buffer = static_cast<T*>(parallax_umalloc(std::min(chunk, n) * sizeof(T), 0));
+        if (!buffer) {
+            for (T* b : staging) parallax_ufree(b);
+            return result;
+        }
+        staging.push_back(buffer);
+    }
+
+    // Per-slot handoff: free -> loaded -> computed -> free
+    struct Slot {
+        std::binary_semaphore free{1};
+        std::binary_semaphore loaded{0};
+        std::binary_semaphore computed{0};
+    };
+    std::vector<Slot> slots(depth);
+    std::atomic<bool> failed{false};
+
+    auto extent = [&](size_t c) { return std::min(chunk, n - c * chunk); };
+
+    std::thread copy_in([&] {
+        for (size_t c = 0; c < chunks; c++) {
+            Slot& slot = slots[c % depth];
+            slot.free.acquire();
+            if (!failed.load(std::memory_order_relaxed)) {
+                std::memcpy(staging[c % depth], src + c * chunk, extent(c) * sizeof(T));
+                metrics().add_staged_in(extent(c) * sizeof(T));
+            }
+            slot.loaded.release();
+        }
+    });
+
+    std::thread copy_out([&] {
+        for (size_t c = 0; c < chunks; c++) {
+            Slot& slot = slots[c % depth];
+            slot.computed.acquire();
+            if (!failed.load(std::memory_order_relaxed)) {
+                std::memcpy(dst + c * chunk, staging[c % depth], extent(c) * sizeof(T));
+                metrics().add_staged_out(extent(c) * sizeof(T));
+            }
+            slot.free.release();
+        }
+    });
+
+    // Compute stays on the calling thread
+    for (size_t c = 0; c < chunks; c++) {
+        Slot& slot = slots[c % depth];
+        slot.loaded.acquire();
+        if (!failed.load(std::memory_order_relaxed) && !kernel(staging[c % depth], extent(c))) {
+            failed.store(true, std::memory_order_relaxed);
+        }
+        slot.computed.release();
+    }
+
+    copy_in.join();
+    copy_out.join();
+    for (T* b : staging) parallax_ufree(b);
+
+    result.ok = !failed.load();
+    return result;
+}
+
+/// In-place variant (std::for_each shape).
+template<typename T, typename Kernel>
+StreamingResult stream_for_each(T* data, size_t n, Kernel&& kernel, StreamingOptions options = {}) {
+    return stream_transform(data, data, n, std::forward<Kernel>(kernel), options);
+}
+
+} // namespace parallax::samples
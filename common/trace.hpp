@@ -0,0 +1,196 @@
+/**
+ * @file trace.hpp
+ * @brief Per-phase launch profiling and Chrome-trace export
+ *
+ * Wall-clock timing around launcher.launch() mixes command recording,
+ * submit, coherence transfers and the kernel. profile_launch() separates
+ * them with probe launches the host can observe:
+ *
+ *   overhead  tiny launch: record + submit + queue wait, no real work
+ *   dispatch  clean launch (nothing dirty) minus overhead
+ *   upload    launch after the host dirtied the range minus the clean launch
+ *   download  first host read of every page after the launch
+ *
+ * Queue wait has no figure of its own: launch() records, submits and
+ * waits for the fence in one blocking call, so the host cannot see when
+ * the GPU picked the work up. It stays folded into overhead.
+ *
+ * Phases recorded through TraceScope are written as Chrome trace JSON
+ * (chrome://tracing, Perfetto) when PARALLAX_TRACE=<file> is set.
+ */
+
+#pragma once
+
+#include <parallax/runtime.h>
+#include <parallax/kernel_launcher.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parallax::samples {
+
+class Tracer {
+public:
+    struct Event {
+        std::string name;
+        std::string category;
+        double start_us;
+        double duration_us;
+        size_t thread;
+        std::vector<std::pair<std::string, double>> args;
+    };
+
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    bool enabled() const { return !path_.empty(); }
+
+    double now_us() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch_).count();
+    }
+
+    void record(Event event) {
+        if (!enabled()) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back(std::move(event));
+    }
+
+    /// Write everything recorded so far; called automatically at exit.
+    void flush() {
+        if (!enabled()) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::ofstream out(path_, std::ios::trunc);
+        out << "{\"traceEvents\":[\n";
+        for (size_t i = 0; i < events_.size(); i++) {
+            const Event& e = events_[i];
+            out << "{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+                << ",\"ts\":" << e.start_us << ",\"dur\":" << e.duration_us << ",\"args\":{";
+            for (size_t a = 0; a < e.args.size(); a++) {
+                out << (a ? "," : "") << "\"" << e.args[a].first << "\":" << e.args[a].second;
+            }
+            out << "}}" << (i + 1 < events_.size() ? ",\n" : "\n");
+        }
+        out << "],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    ~Tracer() { flush(); }
+
+private:
+    Tracer() : epoch_(std::chrono::steady_clock::now()) {
+        if (const char* path = std::getenv("PARALLAX_TRACE")) path_ = path;
+    }
+
+    std::chrono::steady_clock::time_point epoch_;
+    std::string path_;
+    std::mutex mutex_;
+    std::vector<Event> events_;
+};
+
+/// Records one complete ("X") event covering its lifetime.
+class TraceScope {
+public:
+    TraceScope(std::string name, std::string category = "phase")
+        : name_(std::move(name)), category_(std::move(category)),
+          start_us_(Tracer::instance().now_us()) {}
+
+    void arg(std::string key, double value) { args_.emplace_back(std::move(key), value); }
+
+    /// Elapsed so far, in ms.
+    double elapsed_ms() const { return (Tracer::instance().now_us() - start_us_) / 1000.0; }
+
+    ~TraceScope() {
+        auto& tracer = Tracer::instance();
+        if (!tracer.enabled()) return;
+        tracer.record({name_, category_, start_us_, tracer.now_us() - start_us_,
+                       std::hash<std::thread::id>{}(std::this_thread::get_id()) % 100000, std::move(args_)});
+    }
+
+private:
+    std::string name_;
+    std::string category_;
+    double start_us_;
+    std::vector<std::pair<std::string, double>> args_;
+};
+
+struct LaunchStats {
+    size_t upload_bytes = 0;
+    double upload_ms = 0.0;
+    double dispatch_ms = 0.0;
+    size_t download_bytes = 0;
+    double download_ms = 0.0;
+    double overhead_ms = 0.0;  // Record + submit + queue wait (not separable, see above)
+    double total_ms = 0.0;     // The real launch, as the caller would time it
+    bool ok = false;           // Every launch, probes included, succeeded
+};
+
+/// Time a single phase, recording it in the trace.
+template<typename Fn>
+double timed_phase(const std::string& name, Fn&& fn, const std::vector<std::pair<std::string, double>>& args = {}) {
+    TraceScope scope(name);
+    for (const auto& [key, value] : args) scope.arg(key, value);
+    fn();
+    return scope.elapsed_ms();
+}
+
+/// Profile one launch of a (float* data, n, arg) kernel. @p identity_arg
+/// must make the kernel leave data unchanged (1.0 for a multiply) so the
+/// probe launches don't alter the result; the real launch uses @p arg.
+/// The host dirties the first @p dirty_n elements (all by default) before
+/// it, and upload_bytes is what that touched, rounded to whole pages.
+inline LaunchStats profile_launch(KernelLauncher& launcher, const std::string& kernel,
+                                  float* data, size_t n, float arg, float identity_arg,
+                                  size_t dirty_n = SIZE_MAX) {
+    LaunchStats stats;
+    const size_t bytes = n * sizeof(float);
+
+    // Fixed cost: a launch over a few elements of a separate buffer
+    float* probe = static_cast<float*>(parallax_umalloc(256 * sizeof(float), 0));
+    if (!probe) return stats;
+    for (int i = 0; i < 256; i++) probe[i] = 1.0f;
+    // A figure derived from a failed launch is meaningless, so every
+    // launch counts towards ok
+    bool ok = launcher.launch(kernel, probe, 256, identity_arg);
+    stats.overhead_ms = timed_phase("overhead", [&] { ok = launcher.launch(kernel, probe, 256, identity_arg) && ok; });
+    parallax_ufree(probe);
+
+    // Clean launch: make the device copy current, then relaunch
+    ok = launcher.launch(kernel, data, n, identity_arg) && ok;
+    double clean_ms = timed_phase("clean_launch", [&] { ok = launcher.launch(kernel, data, n, identity_arg) && ok; });
+    stats.dispatch_ms = std::max(0.0, clean_ms - stats.overhead_ms);
+
+    // Dirty [0, dirty_n) from the host, one real store per 4 KiB page
+    volatile float* v = data;
+    const size_t dirty = std::min(dirty_n, n);
+    size_t pages = 0;
+    for (size_t i = 0; i < dirty; i += 1024, pages++) v[i] = v[i];
+    stats.upload_bytes = std::min(pages * 4096, bytes);
+
+    // The real launch: upload of dirty data + dispatch
+    stats.total_ms = timed_phase("launch", [&] { ok = launcher.launch(kernel, data, n, arg) && ok; },
+                                 {{"bytes", static_cast<double>(stats.upload_bytes)}});
+    stats.ok = ok;
+    stats.upload_ms = std::max(0.0, stats.total_ms - clean_ms);
+
+    // First host read of every page pulls results back
+    double sink = 0.0;
+    stats.download_ms = timed_phase("download", [&] {
+        for (size_t i = 0; i < n; i += 1024) sink += v[i];
+    }, {{"bytes", static_cast<double>(bytes)}});
+    stats.download_bytes = bytes;
+    (void)sink;
+    return stats;
+}
+
+} // namespace parallax::samples
@@ -0,0 +1,209 @@
+/**
+ * @file umem_pool.hpp
+ * @brief Caching pool in front of parallax_umalloc / parallax_ufree
+ *
+ * Every parallax_umalloc ends up as a device memory allocation, which is
+ * slow and counts against maxMemoryAllocationCount. UnifiedPool rounds
+ * requests up to a size class and keeps freed blocks on per-class free
+ * lists, so allocation churn in benchmark loops is served without going
+ * back to the driver.
+ *
+ *   small/medium (<= 64 MiB)  4 classes per power of two (< 25% slack,
+ *                             e.g. 8193 B -> 10240 B; 4 KiB minimum)
+ *   large        (>  64 MiB)  2 MiB granularity, best fit within 1/8
+ *
+ * Blocks are whole parallax_umalloc allocations rather than carvings of a
+ * shared slab: the runtime tracks coherence per allocation, so a pointer
+ * handed to a kernel must be the start of one.
+ *
+ * Environment:
+ *   PARALLAX_POOL_CACHE_MB  cap on cached (idle) bytes, default 2048
+ */
+
+#pragma once
+
+#include <parallax/runtime.h>
+#include "common/metrics.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace parallax::samples {
+
+class UnifiedPool {
+public:
+    struct Stats {
+        uint64_t driver_allocs = 0;   // parallax_umalloc calls
+        uint64_t driver_frees = 0;    // parallax_ufree calls
+        uint64_t pool_hits = 0;       // Requests served from a free list
+        uint64_t requests = 0;
+        uint64_t bytes_in_use = 0;
+        uint64_t bytes_cached = 0;
+        uint64_t peak_bytes_in_use = 0;
+    };
+
+    static constexpr size_t kMinBlock = 4096;
+    static constexpr size_t kLargeThreshold = size_t(64) << 20;
+    static constexpr size_t kLargeGranularity = size_t(2) << 20;
+
+    /// Process-wide pool. Deliberately never destroyed: static destruction
+    /// order could otherwise run it after the runtime has shut down. Call
+    /// trim() before shutdown to hand idle blocks back explicitly.
+    static UnifiedPool& instance() {
+        static UnifiedPool* pool = new UnifiedPool();
+        return *pool;
+    }
+
+    UnifiedPool() {
+        const char* env = std::getenv("PARALLAX_POOL_CACHE_MB");
+        cache_limit_ = (env ? std::strtoull(env, nullptr, 10) : 2048ull) << 20;
+    }
+
+    UnifiedPool(const UnifiedPool&) = delete;
+    UnifiedPool& operator=(const UnifiedPool&) = delete;
+
+    /// @return nullptr if the runtime cannot allocate even after trimming
+    void* allocate(size_t bytes, unsigned flags = 0) {
+        const size_t size = round_up(bytes == 0 ? 1 : bytes);
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.requests++;
+
+        if (void* p = take_cached(size, flags)) {
+            stats_.pool_hits++;
+            metrics().add_pool_request(true);
+            return p;
+        }
+
+        void* p = parallax_umalloc(size, flags);
+        if (!p && stats_.bytes_cached > 0) {
+            release_cached(0);  // Out of memory: give idle blocks back and retry
+            p = parallax_umalloc(size, flags);
+        }
+        if (!p) return nullptr;
+        metrics().add_pool_request(false);
+        stats_.driver_allocs++;
+        live_[p] = {size, flags};
+        note_in_use(size);
+        return p;
+    }
+
+    void deallocate(void* p) {
+        if (!p) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = live_.find(p);
+        if (it == live_.end()) return;  // Not ours
+        Block block = it->second;
+        live_.erase(it);
+        stats_.bytes_in_use -= block.size;
+        metrics().add_pool_in_use(-static_cast<int64_t>(block.size));
+
+        free_[{block.flags, block.size}].push_back(p);
+        stats_.bytes_cached += block.size;
+        if (stats_.bytes_cached > cache_limit_) release_cached(cache_limit_);
+    }
+
+    /// Return every idle block to the runtime.
+    void trim() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        release_cached(0);
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    /// Usable size of the block backing a request of @p bytes.
+    static size_t round_up(size_t bytes) {
+        if (bytes <= kMinBlock) return kMinBlock;
+        if (bytes > kLargeThreshold) {
+            return (bytes + kLargeGranularity - 1) / kLargeGranularity * kLargeGranularity;
+        }
+        // Four classes per power of two: 2^k * {1, 1.25, 1.5, 1.75}
+        size_t pow2 = kMinBlock;
+        while (pow2 * 2 < bytes) pow2 *= 2;
+        const size_t step = pow2 / 4;
+        return (bytes + step - 1) / step * step;
+    }
+
+private:
+    struct Block {
+        size_t size;
+        unsigned flags;
+    };
+
+    using ClassKey = std::pair<unsigned, size_t>;  // (flags, size)
+
+    void* take_cached(size_t size, unsigned flags) {
+        auto it = free_.lower_bound({flags, size});
+        if (it == free_.end() || it->first.first != flags) return nullptr;
+        // Exact class for small/medium; large blocks may be up to 1/8 bigger
+        const size_t limit = size > kLargeThreshold ? size + size / 8 : size;
+        if (it->first.second > limit || it->second.empty()) return nullptr;
+
+        void* p = it->second.back();
+        it->second.pop_back();
+        const size_t block_size = it->first.second;
+        if (it->second.empty()) free_.erase(it);
+        stats_.bytes_cached -= block_size;
+        live_[p] = {block_size, flags};
+        note_in_use(block_size);
+        return p;
+    }
+
+    // Free idle blocks, largest first, until at most @p keep bytes remain.
+    void release_cached(size_t keep) {
+        while (stats_.bytes_cached > keep && !free_.empty()) {
+            auto largest = free_.begin();
+            for (auto it = free_.begin(); it != free_.end(); ++it) {
+                if (it->first.second > largest->first.second) largest = it;
+            }
+            parallax_ufree(largest->second.back());
+            stats_.driver_frees++;
+            stats_.bytes_cached -= largest->first.second;
+            largest->second.pop_back();
+            if (largest->second.empty()) free_.erase(largest);
+        }
+    }
+
+    void note_in_use(size_t size) {
+        stats_.bytes_in_use += size;
+        metrics().add_pool_in_use(static_cast<int64_t>(size));
+        if (stats_.bytes_in_use > stats_.peak_bytes_in_use) stats_.peak_bytes_in_use = stats_.bytes_in_use;
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<void*, Block> live_;
+    std::map<ClassKey, std::vector<void*>> free_;
+    Stats stats_;
+    uint64_t cache_limit_ = 0;
+};
+
+/// std::allocator-compatible allocator backed by UnifiedPool, for
+/// containers whose storage is handed to offloaded algorithms.
+template<typename T>
+struct pool_allocator {
+    using value_type = T;
+
+    pool_allocator() noexcept = default;
+    template<typename U> pool_allocator(const pool_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        void* p = UnifiedPool::instance().allocate(n * sizeof(T));
+        if (!p) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t) noexcept { UnifiedPool::instance().deallocate(p); }
+
+    template<typename U> bool operator==(const pool_allocator<U>&) const noexcept { return true; }
+    template<typename U> bool operator!=(const pool_allocator<U>&) const noexcept { return false; }
+};
+
+} // namespace parallax::samples
@@ -0,0 +1,157 @@
+/**
+ * @file fft_1d.cpp
+ * @brief Radix-2 complex FFT as a sequence of index-range passes
+ *
+ * A bit-reversal permutation, then log2(N) butterfly stages, each one
+ * std::for_each(par) over N/2 butterfly indices on split re/im arrays with
+ * a precomputed twiddle table. Every stage is a separate dispatch over the
+ * whole array, so this is the launch- and bandwidth-heavy end of FFT
+ * formulations. The CPU baseline runs the same passes through
+ * host_parallel_for.
+ *
+ * Flops use the conventional 5 N log2 N; bytes are the traffic of this
+ * formulation (one read and one write of the array per pass). The input
+ * is two tones, so the spectrum is checked against its closed form.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/host_parallel.hpp"
+#include "common/index_range.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <iostream>
+#include <numbers>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+using parallax::samples::index_begin;
+
+constexpr size_t kTone0 = 3, kTone1 = 17;
+
+struct Signal {
+    float* re;
+    float* im;
+};
+
+// One FFT: permute src into dst, then every stage in place on dst.
+// for_each_index(count, body) runs body over [0, count).
+template<typename ForEachIndex>
+static void fft(Signal src, Signal dst, const float* tw_re, const float* tw_im, size_t n, int log_n,
+                ForEachIndex&& for_each_index) {
+    for_each_index(n, [=](size_t i) {
+        uint32_t r = static_cast<uint32_t>(i);
+        r = ((r >> 1) & 0x55555555u) | ((r & 0x55555555u) << 1);
+        r = ((r >> 2) & 0x33333333u) | ((r & 0x33333333u) << 2);
+        r = ((r >> 4) & 0x0f0f0f0fu) | ((r & 0x0f0f0f0fu) << 4);
+        r = ((r >> 8) & 0x00ff00ffu) | ((r & 0x00ff00ffu) << 8);
+        r = (r >> 16) | (r << 16);
+        r >>= 32 - log_n;
+        dst.re[r] = src.re[i];
+        dst.im[r] = src.im[i];
+    });
+    for (int s = 0; s < log_n; s++) {
+        const size_t half = size_t(1) << s;
+        const size_t stride = n / (2 * half);  // Twiddle step for this stage
+        for_each_index(n / 2, [=](size_t t) {
+            const size_t j = t % half;
+            const size_t i0 = (t / half) * 2 * half + j, i1 = i0 + half;
+            const float wr = tw_re[j * stride], wi = tw_im[j * stride];
+            const float xr = dst.re[i1] * wr - dst.im[i1] * wi;
+            const float xi = dst.re[i1] * wi + dst.im[i1] * wr;
+            dst.re[i1] = dst.re[i0] - xr;
+            dst.im[i1] = dst.im[i0] - xi;
+            dst.re[i0] += xr;
+            dst.im[i0] += xi;
+        });
+    }
+}
+
+// X[k] of cos(2 pi k0 n / N) + 0.5 sin(2 pi k1 n / N)
+static bool spectrum_matches(const float* re, const float* im, size_t n) {
+    const double tol = 1e-4 * n;
+    auto near = [&](size_t k, double er, double ei) {
+        return std::abs(re[k] - er) <= tol && std::abs(im[k] - ei) <= tol;
+    };
+    const double half = n / 2.0, quarter = n / 4.0;
+    return near(kTone0, half, 0.0) && near(n - kTone0, half, 0.0) &&
+           near(kTone1, 0.0, -quarter) && near(n - kTone1, 0.0, quarter) &&
+           near(0, 0.0, 0.0) && near(n / 2, 0.0, 0.0) && near(kTone1 + 1, 0.0, 0.0);
+}
+
+static bool bench_size(BenchHarness& h, int log_n) {
+    const size_t n = size_t(1) << log_n;
+    // Input re/im, output re/im, then the N/2 twiddles
+    std::vector<float*> buffers;
+    for (size_t count : {n, n, n, n, n / 2, n / 2}) {
+        buffers.push_back((float*)parallax_umalloc(count * sizeof(float), 0));
+    }
+    if (std::find(buffers.begin(), buffers.end(), nullptr) != buffers.end()) {
+        std::cerr << "Failed to allocate 2^" << log_n << " FFT buffers" << std::endl;
+        for (float* b : buffers) if (b) parallax_ufree(b);
+        return false;
+    }
+    Signal in{buffers[0], buffers[1]}, out{buffers[2], buffers[3]};
+    const float* tw_re = buffers[4];
+    const float* tw_im = buffers[5];
+    const double two_pi = 2.0 * std::numbers::pi;
+    for (size_t i = 0; i < n; i++) {
+        in.re[i] = static_cast<float>(std::cos(two_pi * kTone0 * i / n) + 0.5 * std::sin(two_pi * kTone1 * i / n));
+        in.im[i] = 0.0f;
+    }
+    for (size_t k = 0; k < n / 2; k++) {
+        buffers[4][k] = static_cast<float>(std::cos(two_pi * k / n));
+        buffers[5][k] = static_cast<float>(-std::sin(two_pi * k / n));
+    }
+    std::vector<float> cpu_re(n), cpu_im(n);
+    
+    auto cpu = h.measure([&] {
+        fft(in, Signal{cpu_re.data(), cpu_im.data()}, tw_re, tw_im, n, log_n, [](size_t count, auto&& body) {
+            parallax::samples::host_parallel_for(count, body);
+        });
+    }, 5);
+    auto gpu = h.measure([&] {
+        fft(in, out, tw_re, tw_im, n, log_n, [](size_t count, auto&& body) {
+            std::for_each(std::execution::par, index_begin(0), index_begin(count), body);
+        });
+    }, 5);
+    
+    const double passes = 1.0 + log_n;
+    Work work{passes * n * 4 * sizeof(float), 5.0 * n * log_n};
+    h.record("fft_1d", "cpu", n, cpu, work, spectrum_matches(cpu_re.data(), cpu_im.data(), n));
+    h.record("fft_1d", "gpu", n, gpu, work, spectrum_matches(out.re, out.im, n));
+    
+    for (float* b : buffers) parallax_ufree(b);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax 1D FFT Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    BenchHarness h("fft_1d", parallax::samples::BenchOptions::parse(argc, argv));
+    h.print_header();
+    
+    bool ok = true;
+    for (int log_n : {16, 20, 22}) ok = bench_size(h, log_n) && ok;
+    
+    std::cout << std::endl;
+    std::cout << "%Peak is the share of the roofline (PARALLAX_PEAK_GBPS / PARALLAX_PEAK_GFLOPS)" << std::endl;
+    
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return ok ? status : 1;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file jacobi_stencil.cpp
+ * @brief 2D 5-point and 3D 7-point Jacobi sweeps over an index range
+ *
+ * Each sweep reads one grid and writes the other, then the two swap. The
+ * GPU side is std::for_each(par) over an index_domain_2d/3d covering the
+ * interior, with the grids captured as pointers; the CPU baseline runs
+ * the same lambda through host_parallel_for. Boundary cells hold a fixed
+ * hot face and are never written.
+ *
+ * Work per sweep is counted at the compulsory traffic (one read and one
+ * write per interior cell), so %Peak against PARALLAX_PEAK_GBPS is the
+ * fraction of the bandwidth roof reached.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/host_parallel.hpp"
+#include "common/index_range.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+using parallax::samples::index_begin;
+using parallax::samples::index_domain_2d;
+using parallax::samples::index_domain_3d;
+
+struct Grid {
+    size_t nx, ny, nz;  // nz == 1 for 2D
+    size_t cells() const { return nx * ny * nz; }
+    size_t interior() const { return (nx - 2) * (ny - 2) * (nz == 1 ? 1 : nz - 2); }
+    bool is3d() const { return nz > 1; }
+};
+
+// Hot face at y == 0, everything else cold
+static void init_grid(const Grid& g, float* a, float* b) {
+    for (size_t i = 0; i < g.cells(); i++) {
+        size_t y = (i / g.nx) % g.ny;
+        a[i] = b[i] = (y == 0) ? 1.0f : 0.0f;
+    }
+}
+
+// The interior as a domain offset by one cell, then the stencil
+static auto sweep_2d(const Grid& g, const float* in, float* out) {
+    const size_t nx = g.nx;
+    return index_domain_2d(g.nx - 2, g.ny - 2, 1, 1).unflatten([=](size_t x, size_t y) {
+        size_t c = y * nx + x;
+        out[c] = 0.25f * (in[c - 1] + in[c + 1] + in[c - nx] + in[c + nx]);
+    });
+}
+
+static auto sweep_3d(const Grid& g, const float* in, float* out) {
+    const size_t nx = g.nx, ny = g.ny, plane = g.nx * g.ny;
+    return index_domain_3d(g.nx - 2, g.ny - 2, g.nz - 2, 1, 1, 1).unflatten([=](size_t x, size_t y, size_t z) {
+        size_t c = (z * ny + y) * nx + x;
+        out[c] = (1.0f / 6.0f) * (in[c - 1] + in[c + 1] + in[c - nx] + in[c + nx] +
+                                  in[c - plane] + in[c + plane]);
+    });
+}
+
+static bool grids_match(const std::vector<float>& cpu, const float* gpu) {
+    for (size_t i = 0; i < cpu.size(); i++) {
+        if (std::abs(cpu[i] - gpu[i]) > 1e-5f) return false;
+    }
+    return true;
+}
+
+template<typename MakeSweep>
+static bool bench_grid(BenchHarness& h, const std::string& name, const Grid& g, int sweeps, MakeSweep sweep) {
+    float* a = (float*)parallax_umalloc(g.cells() * sizeof(float), 0);
+    float* b = (float*)parallax_umalloc(g.cells() * sizeof(float), 0);
+    if (!a || !b) {
+        std::cerr << "Failed to allocate " << name << " grids" << std::endl;
+        if (a) parallax_ufree(a);
+        if (b) parallax_ufree(b);
+        return false;
+    }
+    std::vector<float> cpu_a(g.cells()), cpu_b(g.cells());
+    const size_t n = g.interior();
+    
+    // Returns the grid holding the last sweep
+    auto run = [&](float* x, float* y, auto&& for_each_index) {
+        for (int s = 0; s < sweeps; s++) {
+            for_each_index(sweep(g, x, y));
+            std::swap(x, y);
+        }
+        return x;
+    };
+    
+    float* cpu_result = nullptr;
+    auto cpu = h.measure([&] { init_grid(g, cpu_a.data(), cpu_b.data()); }, [&] {
+        cpu_result = run(cpu_a.data(), cpu_b.data(), [n](auto&& body) {
+            parallax::samples::host_parallel_for(n, body);
+        });
+    }, 5);
+    
+    float* gpu_result = nullptr;
+    auto gpu = h.measure([&] { init_grid(g, a, b); }, [&] {
+        gpu_result = run(a, b, [n](auto&& body) {
+            std::for_each(std::execution::par, index_begin(0), index_begin(n), body);
+        });
+    }, 5);
+    
+    std::vector<float> expected(cpu_result, cpu_result + g.cells());
+    const double points = static_cast<double>(n) * sweeps;
+    Work work{points * 2 * sizeof(float), points * (g.is3d() ? 6.0 : 4.0)};
+    h.record(name, "cpu", g.cells(), cpu, work);
+    h.record(name, "gpu", g.cells(), gpu, work, grids_match(expected, gpu_result));
+    
+    parallax_ufree(a);
+    parallax_ufree(b);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Jacobi Stencil Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    BenchHarness h("jacobi_stencil", parallax::samples::BenchOptions::parse(argc, argv));
+    h.print_header();
+    
+    const int sweeps = 10;
+    bool ok = bench_grid(h, "jacobi_2d", Grid{4096, 4096, 1}, sweeps, sweep_2d) &&
+              bench_grid(h, "jacobi_3d", Grid{256, 256, 256}, sweeps, sweep_3d);
+    
+    std::cout << std::endl;
+    std::cout << sweeps << " sweeps per run; %Peak is the share of the roofline "
+              << "(PARALLAX_PEAK_GBPS / PARALLAX_PEAK_GFLOPS)" << std::endl;
+    
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return ok ? status : 1;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file spmv_csr.cpp
+ * @brief CSR sparse matrix-vector product, y = A * x, one row per index
+ *
+ * Two matrices: the 5-point 2D Poisson operator (regular, five nonzeros
+ * per row, nearly sequential x accesses) and a random pattern with 4-28
+ * nonzeros per row (irregular row lengths, scattered x gathers). The GPU
+ * side is std::for_each(par) over the row indices; the CPU baseline runs
+ * the same row lambda through host_parallel_for.
+ *
+ * Work is the compulsory traffic: values and column indices once, row
+ * pointers, y written once and x read once.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/host_parallel.hpp"
+#include "common/index_range.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+using parallax::samples::index_begin;
+
+// CSR arrays in unified memory, built on the host
+struct CsrMatrix {
+    size_t rows = 0;
+    size_t nnz = 0;
+    uint32_t* row_ptr = nullptr;
+    uint32_t* col = nullptr;
+    float* val = nullptr;
+    
+    CsrMatrix(size_t rows, const std::vector<uint32_t>& ptr, const std::vector<uint32_t>& cols,
+              const std::vector<float>& vals)
+        : rows(rows), nnz(vals.size()) {
+        row_ptr = (uint32_t*)parallax_umalloc(ptr.size() * sizeof(uint32_t), 0);
+        col = (uint32_t*)parallax_umalloc(std::max<size_t>(1, nnz) * sizeof(uint32_t), 0);
+        val = (float*)parallax_umalloc(std::max<size_t>(1, nnz) * sizeof(float), 0);
+        if (!ok()) return;
+        std::copy(ptr.begin(), ptr.end(), row_ptr);
+        std::copy(cols.begin(), cols.end(), col);
+        std::copy(vals.begin(), vals.end(), val);
+    }
+    
+    ~CsrMatrix() {
+        if (row_ptr) parallax_ufree(row_ptr);
+        if (col) parallax_ufree(col);
+        if (val) parallax_ufree(val);
+    }
+    
+    CsrMatrix(const CsrMatrix&) = delete;
+    CsrMatrix& operator=(const CsrMatrix&) = delete;
+    
+    bool ok() const { return row_ptr && col && val; }
+};
+
+static CsrMatrix poisson_2d(size_t g) {
+    std::vector<uint32_t> ptr{0}, cols;
+    std::vector<float> vals;
+    for (size_t r = 0; r < g; r++) {
+        for (size_t c = 0; c < g; c++) {
+            size_t i = r * g + c;
+            if (r > 0) { cols.push_back(i - g); vals.push_back(-1.0f); }
+            if (c > 0) { cols.push_back(i - 1); vals.push_back(-1.0f); }
+            cols.push_back(i); vals.push_back(4.0f);
+            if (c + 1 < g) { cols.push_back(i + 1); vals.push_back(-1.0f); }
+            if (r + 1 < g) { cols.push_back(i + g); vals.push_back(-1.0f); }
+            ptr.push_back(static_cast<uint32_t>(cols.size()));
+        }
+    }
+    return CsrMatrix(g * g, ptr, cols, vals);
+}
+
+static CsrMatrix random_sparse(size_t n) {
+    std::vector<uint32_t> ptr{0}, cols;
+    std::vector<float> vals;
+    uint32_t state = 2024u;
+    auto next = [&] { return state = state * 1664525u + 1013904223u; };  // LCG
+    for (size_t r = 0; r < n; r++) {
+        size_t count = 4 + next() % 25;
+        for (size_t k = 0; k < count; k++) {
+            cols.push_back(next() % static_cast<uint32_t>(n));
+            vals.push_back(static_cast<float>(next() % 8) * 0.125f - 0.5f);
+        }
+        std::sort(cols.end() - count, cols.end());
+        ptr.push_back(static_cast<uint32_t>(cols.size()));
+    }
+    return CsrMatrix(n, ptr, cols, vals);
+}
+
+static auto spmv_row(const CsrMatrix& a, const float* x, float* y) {
+    const uint32_t* row_ptr = a.row_ptr;
+    const uint32_t* col = a.col;
+    const float* val = a.val;
+    return [=](size_t r) {
+        float sum = 0.0f;
+        for (uint32_t k = row_ptr[r]; k < row_ptr[r + 1]; k++) sum += val[k] * x[col[k]];
+        y[r] = sum;
+    };
+}
+
+static bool bench_matrix(BenchHarness& h, const std::string& name, const CsrMatrix& a) {
+    const size_t n = a.rows;
+    float* x = (float*)parallax_umalloc(n * sizeof(float), 0);
+    float* y = (float*)parallax_umalloc(n * sizeof(float), 0);
+    if (!a.ok() || !x || !y) {
+        std::cerr << "Failed to allocate " << name << std::endl;
+        if (x) parallax_ufree(x);
+        if (y) parallax_ufree(y);
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) x[i] = static_cast<float>(i % 17) * 0.25f;
+    std::vector<float> cpu_y(n);
+    
+    auto cpu = h.measure([&] {
+        parallax::samples::host_parallel_for(n, spmv_row(a, x, cpu_y.data()));
+    }, 10);
+    auto gpu = h.measure([&] {
+        std::for_each(std::execution::par, index_begin(0), index_begin(n), spmv_row(a, x, y));
+    }, 10);
+    
+    bool correct = true;
+    for (size_t i = 0; i < n && correct; i++) {
+        correct = std::abs(cpu_y[i] - y[i]) <= 1e-5f * std::abs(cpu_y[i]) + 1e-5f;
+    }
+    Work work{static_cast<double>(a.nnz) * (sizeof(float) + sizeof(uint32_t)) +
+                  (n + 1) * sizeof(uint32_t) + 2.0 * n * sizeof(float),
+              2.0 * a.nnz};
+    h.record(name, "cpu", n, cpu, work);
+    h.record(name, "gpu", n, gpu, work, correct);
+    
+    parallax_ufree(x);
+    parallax_ufree(y);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax CSR SpMV Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    BenchHarness h("spmv_csr", parallax::samples::BenchOptions::parse(argc, argv));
+    h.print_header();
+    
+    bool ok = true;
+    {
+        CsrMatrix poisson = poisson_2d(2048);
+        ok = bench_matrix(h, "spmv_poisson", poisson) && ok;
+    }
+    {
+        CsrMatrix random = random_sparse(1 << 20);
+        ok = bench_matrix(h, "spmv_random", random) && ok;
+    }
+    
+    std::cout << std::endl;
+    std::cout << "%Peak is the share of the roofline (PARALLAX_PEAK_GBPS / PARALLAX_PEAK_GFLOPS)" << std::endl;
+    
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return ok ? status : 1;
+}
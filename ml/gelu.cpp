@@ -0,0 +1,98 @@
+/**
+ * @file gelu.cpp
+ * @brief Bias + GELU activation over a batch in one dispatch
+ *
+ * y = gelu(x + bias) with the tanh approximation
+ *   0.5 v (1 + tanh(sqrt(2/pi) (v + 0.044715 v^3)))
+ * as one std::for_each(par) over element indices; the column for the bias
+ * is i % kWidth, which a plain std::transform over x could not see. Purely
+ * element-wise, so the interesting end is batch 1, where a 1024-element
+ * launch is almost all overhead. The CPU baseline is the same lambda
+ * through host_parallel_for. Size is the batch, so B/el is bytes per row.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/host_parallel.hpp"
+#include "common/index_range.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <iostream>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+using parallax::samples::index_begin;
+
+constexpr size_t kWidth = 1024;
+constexpr size_t kBatches[] = {1, 8, 64, 512, 4096};
+
+static auto bias_gelu(const float* x, const float* bias, float* y) {
+    return [=](size_t i) {
+        const float v = x[i] + bias[i % kWidth];
+        y[i] = 0.5f * v * (1.0f + std::tanh(0.7978845608f * (v + 0.044715f * v * v * v)));
+    };
+}
+
+static bool bench_batch(BenchHarness& h, size_t batch) {
+    const size_t n = batch * kWidth;
+    float* x = (float*)parallax_umalloc(n * sizeof(float), 0);
+    float* y = (float*)parallax_umalloc(n * sizeof(float), 0);
+    float* bias = (float*)parallax_umalloc(kWidth * sizeof(float), 0);
+    if (!x || !y || !bias) {
+        std::cerr << "Failed to allocate batch " << batch << std::endl;
+        for (float* p : {x, y, bias}) if (p) parallax_ufree(p);
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) x[i] = static_cast<float>((i * 13) % 97) * 0.08f - 4.0f;
+    for (size_t k = 0; k < kWidth; k++) bias[k] = static_cast<float>(k % 5) * 0.1f - 0.2f;
+    std::vector<float> cpu_y(n);
+    
+    auto cpu = h.measure([&] {
+        parallax::samples::host_parallel_for(n, bias_gelu(x, bias, cpu_y.data()));
+    }, 10);
+    auto gpu = h.measure([&] {
+        std::for_each(std::execution::par, index_begin(0), index_begin(n), bias_gelu(x, bias, y));
+    }, 10);
+    
+    bool correct = true;
+    for (size_t i = 0; i < n && correct; i++) {
+        correct = std::abs(cpu_y[i] - y[i]) <= 1e-5f * std::abs(cpu_y[i]) + 1e-6f;
+    }
+    // Activations in, activations out; add, 3 mul + fma for the cubic term, tanh, 3 mul/add
+    Work work{2.0 * n * sizeof(float) + kWidth * sizeof(float), 9.0 * n};
+    h.record("gelu", "cpu", batch, cpu, work);
+    h.record("gelu", "gpu", batch, gpu, work, correct);
+    
+    for (float* p : {x, y, bias}) parallax_ufree(p);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Bias + GELU Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    BenchHarness h("gelu", parallax::samples::BenchOptions::parse(argc, argv));
+    h.print_header();
+    
+    bool ok = true;
+    for (size_t batch : kBatches) ok = bench_batch(h, batch) && ok;
+    
+    std::cout << std::endl;
+    std::cout << "Size is the batch (rows of " << kWidth << " floats)" << std::endl;
+    
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return ok ? status : 1;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file layernorm.cpp
+ * @brief Row-wise layer normalization over a batch: one dispatch vs per-row reductions
+ *
+ * y = (x - mean) / sqrt(var + eps) * gamma + beta per row of kWidth floats,
+ * with gamma/beta shared across rows. Two GPU formulations:
+ *   batched  one std::for_each(par) over row indices, two-pass mean and
+ *            variance then the affine write, all in one invocation per row
+ *   row      for every row, a mean std::transform_reduce, a variance
+ *            std::transform_reduce and a std::for_each(par) over the column
+ *            indices for the write (three launches per row)
+ * The CPU baseline runs the batched row lambda through host_parallel_for.
+ * Size is the batch, so B/el is bytes per row.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/host_parallel.hpp"
+#include "common/index_range.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+using parallax::samples::index_begin;
+
+constexpr size_t kWidth = 1024;
+constexpr size_t kBatches[] = {1, 8, 64, 512, 4096};
+constexpr float kEps = 1e-5f;
+
+static auto layernorm_row(const float* x, const float* gamma, const float* beta, float* y) {
+    return [=](size_t r) {
+        const float* in = x + r * kWidth;
+        float* out = y + r * kWidth;
+        float sum = 0.0f;
+        for (size_t k = 0; k < kWidth; k++) sum += in[k];
+        const float mean = sum / kWidth;
+        float sq = 0.0f;
+        for (size_t k = 0; k < kWidth; k++) sq += (in[k] - mean) * (in[k] - mean);
+        const float rstd = 1.0f / std::sqrt(sq / kWidth + kEps);
+        for (size_t k = 0; k < kWidth; k++) out[k] = (in[k] - mean) * rstd * gamma[k] + beta[k];
+    };
+}
+
+static void layernorm_per_row(const float* x, const float* gamma, const float* beta, float* y, size_t batch) {
+    for (size_t r = 0; r < batch; r++) {
+        const float* in = x + r * kWidth;
+        float* out = y + r * kWidth;
+        const float mean = std::transform_reduce(std::execution::par, in, in + kWidth, 0.0f, std::plus<float>(),
+                                                 [](float v) { return v; }) / kWidth;
+        const float var = std::transform_reduce(std::execution::par, in, in + kWidth, 0.0f, std::plus<float>(),
+                                                [mean](float v) { return (v - mean) * (v - mean); }) / kWidth;
+        const float rstd = 1.0f / std::sqrt(var + kEps);
+        std::for_each(std::execution::par, index_begin(0), index_begin(kWidth), [=](size_t k) {
+            out[k] = (in[k] - mean) * rstd * gamma[k] + beta[k];
+        });
+    }
+}
+
+static bool rows_match(const std::vector<float>& expected, const float* actual) {
+    for (size_t i = 0; i < expected.size(); i++) {
+        if (std::abs(expected[i] - actual[i]) > 1e-4f * std::abs(expected[i]) + 1e-4f) return false;
+    }
+    return true;
+}
+
+static bool bench_batch(BenchHarness& h, size_t batch) {
+    const size_t n = batch * kWidth;
+    float* x = (float*)parallax_umalloc(n * sizeof(float), 0);
+    float* y = (float*)parallax_umalloc(n * sizeof(float), 0);
+    float* gamma = (float*)parallax_umalloc(kWidth * sizeof(float), 0);
+    float* beta = (float*)parallax_umalloc(kWidth * sizeof(float), 0);
+    if (!x || !y || !gamma || !beta) {
+        std::cerr << "Failed to allocate batch " << batch << std::endl;
+        for (float* p : {x, y, gamma, beta}) if (p) parallax_ufree(p);
+        return false;
+    }
+    // Activations with a per-row offset and scale so every row normalizes differently
+    for (size_t i = 0; i < n; i++) {
+        size_t r = i / kWidth;
+        x[i] = static_cast<float>(r % 5) + static_cast<float>((i * 29) % 41) * 0.05f * (1 + r % 3);
+    }
+    for (size_t k = 0; k < kWidth; k++) {
+        gamma[k] = 1.0f + static_cast<float>(k % 7) * 0.1f;
+        beta[k] = static_cast<float>(k % 3) * 0.5f - 0.5f;
+    }
+    std::vector<float> cpu_y(n);
+    
+    auto cpu = h.measure([&] {
+        parallax::samples::host_parallel_for(batch, layernorm_row(x, gamma, beta, cpu_y.data()));
+    }, 5);
+    auto batched = h.measure([&] {
+        std::for_each(std::execution::par, index_begin(0), index_begin(batch), layernorm_row(x, gamma, beta, y));
+    }, 5);
+    bool batched_ok = rows_match(cpu_y, y);
+    std::fill(y, y + n, 0.0f);
+    auto per_row = h.measure([&] { layernorm_per_row(x, gamma, beta, y, batch); }, 5);
+    
+    // Compulsory traffic: activations in, normalized out (gamma/beta stay cached);
+    // sum, sub + fma for the variance, sub, mul, fma for the write
+    Work work{2.0 * n * sizeof(float) + 2.0 * kWidth * sizeof(float), 7.0 * n};
+    h.record("layernorm", "cpu", batch, cpu, work);
+    h.record("layernorm", "gpu", batch, batched, work, batched_ok);
+    h.record("layernorm_row", "gpu", batch, per_row, work, rows_match(cpu_y, y));
+    
+    for (float* p : {x, y, gamma, beta}) parallax_ufree(p);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax LayerNorm Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    BenchHarness h("layernorm", parallax::samples::BenchOptions::parse(argc, argv));
+    h.print_header();
+    
+    bool ok = true;
+    for (size_t batch : kBatches) ok = bench_batch(h, batch) && ok;
+    
+    std::cout << std::endl;
+    std::cout << "Size is the batch (rows of " << kWidth << " floats); layernorm_row issues "
+              << "3 launches per row" << std::endl;
+    
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return ok ? status : 1;
+}
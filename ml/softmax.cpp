@@ -0,0 +1,136 @@
+/**
+ * @file softmax.cpp
+ * @brief Row-wise softmax over a batch: one dispatch vs per-row reductions
+ *
+ * Each row is exp(x - max) / sum(exp(x - max)). Two GPU formulations:
+ *   batched  one std::for_each(par) over row indices; each invocation does
+ *            the max pass, the exp-sum pass and the normalize pass for its row
+ *   row      for every row, a max std::transform_reduce, an exp-sum
+ *            std::transform_reduce and a normalizing std::transform, i.e.
+ *            three small launches per row
+ * The CPU baseline runs the batched row lambda through host_parallel_for.
+ *
+ * The batch (rows of kWidth floats) is the scaling axis; at batch 1 the
+ * batched form has a single invocation, at 4096 the per-row form issues
+ * 12K launches. Size is the batch, so B/el is bytes per row.
+ */
+
+#include <parallax/runtime.h>
+#include <parallax/runtime.hpp>
+#include <parallax/execution_policy.hpp>
+#include <parallax/execution_policy_impl.hpp>
+#include "common/bench_harness.hpp"
+#include "common/host_parallel.hpp"
+#include "common/index_range.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using parallax::samples::BenchHarness;
+using parallax::samples::Work;
+using parallax::samples::index_begin;
+
+constexpr size_t kWidth = 1024;
+constexpr size_t kBatches[] = {1, 8, 64, 512, 4096};
+
+static auto softmax_row(const float* x, float* y) {
+    return [=](size_t r) {
+        const float* in = x + r * kWidth;
+        float* out = y + r * kWidth;
+        float m = in[0];
+        for (size_t k = 1; k < kWidth; k++) m = std::max(m, in[k]);
+        float sum = 0.0f;
+        for (size_t k = 0; k < kWidth; k++) {
+            out[k] = std::exp(in[k] - m);
+            sum += out[k];
+        }
+        const float inv = 1.0f / sum;
+        for (size_t k = 0; k < kWidth; k++) out[k] *= inv;
+    };
+}
+
+static void softmax_per_row(const float* x, float* y, size_t batch) {
+    for (size_t r = 0; r < batch; r++) {
+        const float* in = x + r * kWidth;
+        float m = std::transform_reduce(std::execution::par, in, in + kWidth, std::numeric_limits<float>::lowest(),
+                                        [](float a, float b) { return std::max(a, b); },
+                                        [](float v) { return v; });
+        float sum = std::transform_reduce(std::execution::par, in, in + kWidth, 0.0f, std::plus<float>(),
+                                          [m](float v) { return std::exp(v - m); });
+        const float inv = 1.0f / sum;
+        std::transform(std::execution::par, in, in + kWidth, y + r * kWidth,
+                       [m, inv](float v) { return std::exp(v - m) * inv; });
+    }
+}
+
+static bool rows_match(const std::vector<float>& expected, const float* actual) {
+    for (size_t i = 0; i < expected.size(); i++) {
+        if (std::abs(expected[i] - actual[i]) > 1e-4f * expected[i] + 1e-7f) return false;
+    }
+    return true;
+}
+
+static bool bench_batch(BenchHarness& h, size_t batch) {
+    const size_t n = batch * kWidth;
+    float* x = (float*)parallax_umalloc(n * sizeof(float), 0);
+    float* y = (float*)parallax_umalloc(n * sizeof(float), 0);
+    if (!x || !y) {
+        std::cerr << "Failed to allocate batch " << batch << std::endl;
+        if (x) parallax_ufree(x);
+        if (y) parallax_ufree(y);
+        return false;
+    }
+    // Logits in [-8, 8), a different pattern per row
+    for (size_t i = 0; i < n; i++) x[i] = static_cast<float>((i * 37 + i / kWidth * 11) % 64) * 0.25f - 8.0f;
+    std::vector<float> cpu_y(n);
+    
+    auto cpu = h.measure([&] {
+        parallax::samples::host_parallel_for(batch, softmax_row(x, cpu_y.data()));
+    }, 5);
+    auto batched = h.measure([&] {
+        std::for_each(std::execution::par, index_begin(0), index_begin(batch), softmax_row(x, y));
+    }, 5);
+    bool batched_ok = rows_match(cpu_y, y);
+    std::fill(y, y + n, 0.0f);
+    auto per_row = h.measure([&] { softmax_per_row(x, y, batch); }, 5);
+    
+    // Compulsory traffic: logits in, probabilities out; max, sub, exp, add, mul per element
+    Work work{2.0 * n * sizeof(float), 5.0 * n};
+    h.record("softmax", "cpu", batch, cpu, work);
+    h.record("softmax", "gpu", batch, batched, work, batched_ok);
+    h.record("softmax_row", "gpu", batch, per_row, work, rows_match(cpu_y, y));
+    
+    parallax_ufree(x);
+    parallax_ufree(y);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::cout << "========================================" << std::endl;
+    std::cout << "Parallax Softmax Benchmark" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::endl;
+    
+    auto* backend = parallax::get_global_backend();
+    auto* memory = parallax::get_global_memory_manager();
+    if (backend && memory) parallax::ExecutionPolicyImpl::instance().initialize(backend, memory);
+    
+    BenchHarness h("softmax", parallax::samples::BenchOptions::parse(argc, argv));
+    h.print_header();
+    
+    bool ok = true;
+    for (size_t batch : kBatches) ok = bench_batch(h, batch) && ok;
+    
+    std::cout << std::endl;
+    std::cout << "Size is the batch (rows of " << kWidth << " floats); softmax_row issues "
+              << "3 launches per row" << std::endl;
+    
+    int status = h.finish();
+    if (backend) parallax::ExecutionPolicyImpl::instance().shutdown();
+    return ok ? status : 1;
+}